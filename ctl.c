@@ -0,0 +1,253 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include <linux/input.h>
+
+#include "ctl.h"
+#include "emul.h"
+#include "mouse-emul.h"
+#include "options.h"
+#include "stats.h"
+
+static struct emul *emul;
+static int (*switch_profile)(const char *name);
+
+static void process_listen(struct source *src);
+static void process_client(struct source *src);
+
+static struct source listen_src = { .fd = -1, .process = process_listen };
+/* Free slots have fd -1, so they're never processed from a stale batch */
+static struct source clients[CTL_CLIENTS_MAX];
+
+static void client_close(struct source *src)
+{
+	loop_del(src);
+	close(src->fd);
+	src->fd = -1;
+}
+
+static int set_enabled(int32_t value)
+{
+	if (value < -1 || value > 1)
+		return -EINVAL;
+
+	emul->enabled = value == -1 ? !emul->enabled : value;
+	/* As if the direction keys were let go */
+	if (!emul->enabled && motion_active(emul))
+		motion_stop(emul);
+
+	return 0;
+}
+
+static void fill_stats(struct ctl_stats *cs)
+{
+	cs->events_in = stats.events_in;
+	cs->events_out = stats.events_out;
+	cs->reads = stats.reads;
+	cs->writes = stats.writes;
+	cs->latency_cnt = stats.latency_cnt;
+	cs->latency_p50 = stats_latency(0.5);
+	cs->latency_p99 = stats_latency(0.99);
+	cs->latency_max = stats.latency_max;
+}
+
+static int handle_request(struct ctl_request *req, size_t len,
+			  struct ctl_stats *cs)
+{
+	switch (req->cmd) {
+	case CTL_STATS:
+		fill_stats(cs);
+		return 0;
+	case CTL_ENABLE:
+		return set_enabled(req->value);
+	case CTL_PROFILE:
+		if (len == sizeof(*req) || ((char *)req)[len - 1] != '\0')
+			return -EINVAL;
+		return switch_profile(req->payload) ? -EINVAL : 0;
+	case CTL_MOVE:
+		if (req->value)
+			send_event(&emul->mouse, EV_REL, REL_X, req->value);
+		if (req->value2)
+			send_event(&emul->mouse, EV_REL, REL_Y, req->value2);
+		send_event(&emul->mouse, EV_SYN, SYN_REPORT, 0);
+		return 0;
+	case CTL_BUTTON:
+		if (req->code != BTN_LEFT && req->code != BTN_RIGHT &&
+		    req->code != BTN_MIDDLE)
+			return -EINVAL;
+		send_event(&emul->mouse, EV_KEY, req->code, !!req->value);
+		send_event(&emul->mouse, EV_SYN, SYN_REPORT, 0);
+		return 0;
+	case CTL_KEY:
+		if (req->code >= KEY_CNT || req->value < 0 || req->value > 2)
+			return -EINVAL;
+		/* The kernel would drop it silently */
+		if (!kbd_has_key(req->code))
+			return -EINVAL;
+		send_event(&emul->kbd, EV_KEY, req->code, req->value);
+		send_event(&emul->kbd, EV_SYN, SYN_REPORT, 0);
+		return 0;
+	}
+
+	return -EINVAL;
+}
+
+static void process_client(struct source *src)
+{
+	char buf[CTL_MSG_MAX];
+	struct {
+		struct ctl_reply reply;
+		struct ctl_stats stats;
+	} out;
+	struct ctl_request *req = (struct ctl_request *)buf;
+	size_t len = sizeof(out.reply);
+	ssize_t cnt;
+
+	for (;;) {
+		cnt = recv(src->fd, buf, sizeof(buf), MSG_DONTWAIT);
+		if (cnt == -1 && errno == EINTR)
+			continue;
+		if (cnt == -1 && errno == EAGAIN)
+			return;
+		if (cnt <= 0) {
+			client_close(src);
+			return;
+		}
+
+		memset(&out, 0, sizeof(out));
+		if (cnt < sizeof(*req))
+			out.reply.status = -EINVAL;
+		else
+			out.reply.status = handle_request(req, cnt, &out.stats);
+		/* Injected events go out in order of requests, mouse and kbd
+		 * ones aren't reordered at the end of the loop iteration
+		 */
+		emul_flush(emul);
+		if (!out.reply.status && req->cmd == CTL_STATS)
+			len += sizeof(out.stats);
+		out.reply.enabled = emul->enabled;
+
+		if (send(src->fd, &out, len, MSG_DONTWAIT | MSG_NOSIGNAL) != len) {
+			client_close(src);
+			return;
+		}
+		len = sizeof(out.reply);
+	}
+}
+
+static void process_listen(struct source *src)
+{
+	int fd, i;
+
+	for (;;) {
+		fd = accept4(src->fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd == -1) {
+			if (errno == EINTR)
+				continue;
+			if (errno != EAGAIN)
+				warn("Could not accept control connection: %s\n",
+				     strerror(errno));
+			return;
+		}
+
+		for (i = 0; i < CTL_CLIENTS_MAX && clients[i].fd != -1; i++)
+			;
+		if (i == CTL_CLIENTS_MAX) {
+			warn("Too many control connections\n");
+			close(fd);
+			continue;
+		}
+		clients[i].fd = fd;
+		clients[i].process = process_client;
+		if (loop_add(&clients[i], EPOLLIN)) {
+			close(fd);
+			clients[i].fd = -1;
+		}
+	}
+}
+
+/* Only the owner may connect, it can type anything */
+void ctl_init(const char *name, struct emul *e,
+	      int (*profile)(const char *name))
+{
+	struct sockaddr_un addr;
+	struct stat st;
+	mode_t mask;
+	int i;
+
+	emul = e;
+	switch_profile = profile;
+	for (i = 0; i < CTL_CLIENTS_MAX; i++)
+		clients[i].fd = -1;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (strlen(name) >= sizeof(addr.sun_path))
+		die("Control socket name %s is too long\n", name);
+	strcpy(addr.sun_path, name);
+
+	listen_src.fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK |
+			       SOCK_CLOEXEC, 0);
+	if (listen_src.fd == -1)
+		die("Could not create control socket: %s\n", strerror(errno));
+
+	/* Stale socket of a previous run, but never anything else */
+	if (lstat(name, &st) == 0 && S_ISSOCK(st.st_mode))
+		unlink(name);
+	mask = umask(0077);
+	if (bind(listen_src.fd, (struct sockaddr *)&addr, sizeof(addr))) {
+		umask(mask);
+		die("Could not bind control socket %s: %s\n", name,
+		    strerror(errno));
+	}
+	umask(mask);
+
+	if (listen(listen_src.fd, CTL_CLIENTS_MAX) ||
+	    loop_add(&listen_src, EPOLLIN))
+		die("Could not listen on control socket %s: %s\n", name,
+		    strerror(errno));
+}
+
+void ctl_close(void)
+{
+	int i;
+
+	if (listen_src.fd == -1)
+		return;
+
+	for (i = 0; i < CTL_CLIENTS_MAX; i++) {
+		if (clients[i].fd != -1)
+			client_close(&clients[i]);
+	}
+	close(listen_src.fd);
+	listen_src.fd = -1;
+	unlink(ctl_name);
+}
@@ -0,0 +1,75 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#ifndef __CTL_H
+#define __CTL_H
+
+#include <stdint.h>
+
+#include "emul.h"
+
+/* Control socket protocol. Requests and replies are SOCK_SEQPACKET
+ * messages in host byte order, every request gets one reply
+ */
+enum ctl_cmds {
+	CTL_STATS = 1,
+	/* value: 0 turns emulation off, 1 on, -1 toggles it */
+	CTL_ENABLE,
+	/* payload: NUL-terminated name of the config file to switch to */
+	CTL_PROFILE,
+	/* value and value2: relative x and y motion */
+	CTL_MOVE,
+	/* code: BTN_LEFT, BTN_RIGHT or BTN_MIDDLE, value: 1 press, 0 release */
+	CTL_BUTTON,
+	/* code: key on the emulated keyboard, value as for the button */
+	CTL_KEY,
+};
+
+struct ctl_request {
+	uint16_t cmd;
+	uint16_t code;
+	int32_t value, value2;
+	char payload[];
+};
+
+/* Followed by struct ctl_stats for CTL_STATS */
+struct ctl_reply {
+	/* 0 or -errno */
+	int32_t status;
+	/* Emulation state after the request */
+	int32_t enabled;
+};
+
+/* Latency in microseconds */
+struct ctl_stats {
+	uint64_t events_in, events_out;
+	uint64_t reads, writes;
+	uint64_t latency_cnt, latency_p50, latency_p99, latency_max;
+};
+
+#define CTL_CLIENTS_MAX 8
+#define CTL_MSG_MAX 4096
+
+void ctl_init(const char *name, struct emul *emul,
+	      int (*profile)(const char *name));
+void ctl_close(void);
+
+#endif
@@ -0,0 +1,419 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+
+#include <linux/input.h>
+#include <linux/netlink.h>
+
+#include "devices.h"
+#include "mouse-emul.h"
+#include "options.h"
+
+#define UEVENT_BUF_SIZE 4096
+
+struct evdev *evdevs;
+int evdev_cnt;
+
+void (*device_removed)(struct evdev *dev);
+int (*device_start)(struct evdev *dev);
+void (*device_stop)(struct evdev *dev);
+
+/* Removed devices are freed once the epoll batch they may be in is done */
+static struct evdev *dead;
+static void (*process_device)(struct source *src);
+
+static void process_uevent(struct source *src);
+static struct source uevent_src = { .fd = -1, .process = process_uevent };
+
+static int rule_matches(const struct match_rule *rule, const char *name,
+			const struct input_id *id, const unsigned long *keys)
+{
+	if (rule->name[0] && !strstr(name, rule->name))
+		return 0;
+	if (rule->vendor && rule->vendor != id->vendor)
+		return 0;
+	if (rule->product && rule->product != id->product)
+		return 0;
+	if (rule->key && !test_bit(rule->key, keys))
+		return 0;
+
+	return 1;
+}
+
+/* Check device against match rules from config */
+static int device_matches(int fd)
+{
+	char name[256] = "";
+	struct input_id id;
+	unsigned long keys[NLONGS(KEY_CNT)];
+	int i;
+
+	memset(keys, 0, sizeof(keys));
+	if (ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name) < 0 ||
+	    ioctl(fd, EVIOCGID, &id) < 0 ||
+	    ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keys)), keys) < 0)
+		return 0;
+
+	/* Never grab our own uinput devices */
+	if (strncmp(name, EMU_NAME_PREFIX, strlen(EMU_NAME_PREFIX)) == 0)
+		return 0;
+
+	for (i = 0; i < config->rules_cnt; i++) {
+		if (rule_matches(&config->rules[i], name, &id, keys))
+			return 1;
+	}
+
+	return 0;
+}
+
+static struct evdev *device_find(const char *path)
+{
+	struct evdev *dev;
+
+	for (dev = evdevs; dev; dev = dev->next) {
+		if (strcmp(dev->path, path) == 0)
+			return dev;
+	}
+
+	return NULL;
+}
+
+/* Devices are read edge-triggered, until EAGAIN */
+static int device_open(struct evdev *dev)
+{
+	int clk;
+
+	dev->src.fd = open(dev->path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+	if (dev->src.fd == -1) {
+		warn("Could not open %s: %s\n", dev->path, strerror(errno));
+		return -1;
+	}
+	if (ioctl(dev->src.fd, EVIOCGRAB, 1)) {
+		warn("Could not grab %s: %s\n", dev->path, strerror(errno));
+		goto err;
+	}
+	/* Acceleration compares event timestamps with motion timer */
+	clk = CLOCK_MONOTONIC;
+	if (ioctl(dev->src.fd, EVIOCSCLOCKID, &clk))
+		warn("Could not set clock for %s: %s\n", dev->path, strerror(errno));
+	memset(dev->keys, 0, sizeof(dev->keys));
+	dev->pending = 0;
+
+	if (device_start ? device_start(dev) :
+	    loop_add(&dev->src, EPOLLIN | EPOLLET))
+		goto err;
+	evdev_cnt++;
+
+	return 0;
+err:
+	close(dev->src.fd);
+	dev->src.fd = -1;
+	return -1;
+}
+
+static struct evdev *device_new(const char *path, int is_static)
+{
+	struct evdev *dev;
+
+	dev = calloc(1, sizeof(*dev));
+	if (!dev)
+		die("Could not allocate device: %s\n", strerror(errno));
+
+	dev->src.fd = -1;
+	dev->src.process = process_device;
+	dev->is_static = is_static;
+	strncpy(dev->path, path, sizeof(dev->path) - 1);
+	dev->next = evdevs;
+	evdevs = dev;
+
+	return dev;
+}
+
+static void device_unlink(struct evdev *dev)
+{
+	struct evdev **ptr;
+
+	for (ptr = &evdevs; *ptr; ptr = &(*ptr)->next) {
+		if (*ptr == dev) {
+			*ptr = dev->next;
+			return;
+		}
+	}
+}
+
+/* Open a device which appeared, either one from -d list or matching rules */
+static void device_add(const char *path)
+{
+	struct evdev *dev;
+	int fd;
+
+	dev = device_find(path);
+	if (dev) {
+		if (dev->src.fd == -1 && device_open(dev) == 0)
+			warn("Reopened %s\n", path);
+		return;
+	}
+
+	if (!config->rules_cnt)
+		return;
+
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return;
+	if (!device_matches(fd)) {
+		close(fd);
+		return;
+	}
+	close(fd);
+
+	dev = device_new(path, 0);
+	if (device_open(dev)) {
+		device_unlink(dev);
+		free(dev);
+		return;
+	}
+	warn("Added %s\n", path);
+}
+
+void device_remove(struct evdev *dev)
+{
+	if (dev->src.fd == -1)
+		return;
+
+	if (device_removed)
+		device_removed(dev);
+
+	/* It may be gone already, so don't complain about ungrab */
+	if (device_stop)
+		device_stop(dev);
+	else
+		loop_del(&dev->src);
+	ioctl(dev->src.fd, EVIOCGRAB, 0);
+	close(dev->src.fd);
+	dev->src.fd = -1;
+	evdev_cnt--;
+	warn("Removed %s\n", dev->path);
+
+	/* Static devices are kept to be reopened */
+	if (!dev->is_static) {
+		device_unlink(dev);
+		dev->next = dead;
+		dead = dev;
+	}
+}
+
+/* Called when no epoll event may point to removed devices anymore */
+void devices_reap(void)
+{
+	struct evdev *dev;
+
+	while (dead) {
+		dev = dead;
+		dead = dev->next;
+		free(dev);
+	}
+}
+
+/* Pick up devices matching rules, i.e. at startup or after config reload */
+void devices_scan(void)
+{
+	DIR *dir;
+	struct dirent *ent;
+	char path[PATH_MAX];
+
+	if (!config->rules_cnt)
+		return;
+
+	dir = opendir("/dev/input");
+	if (!dir) {
+		warn("Could not open /dev/input: %s\n", strerror(errno));
+		return;
+	}
+	while ((ent = readdir(dir)) != NULL) {
+		if (strncmp(ent->d_name, "event", 5) != 0)
+			continue;
+		snprintf(path, sizeof(path), "/dev/input/%s", ent->d_name);
+		device_add(path);
+	}
+	closedir(dir);
+}
+
+/* Kernel uevents are "action@devpath" followed by KEY=value strings */
+static void process_uevent(struct source *src)
+{
+	char buf[UEVENT_BUF_SIZE], path[PATH_MAX];
+	const char *action = NULL, *devname = NULL, *subsystem = NULL;
+	struct sockaddr_nl addr;
+	socklen_t addrlen = sizeof(addr);
+	struct evdev *dev;
+	ssize_t len;
+	char *ptr;
+
+	len = recvfrom(src->fd, buf, sizeof(buf) - 1, 0,
+		       (struct sockaddr *)&addr, &addrlen);
+	/* Only trust messages from the kernel */
+	if (len <= 0 || addr.nl_pid != 0)
+		return;
+	buf[len] = '\0';
+
+	for (ptr = buf; ptr < buf + len; ptr += strlen(ptr) + 1) {
+		if (strncmp(ptr, "ACTION=", 7) == 0)
+			action = ptr + 7;
+		else if (strncmp(ptr, "DEVNAME=", 8) == 0)
+			devname = ptr + 8;
+		else if (strncmp(ptr, "SUBSYSTEM=", 10) == 0)
+			subsystem = ptr + 10;
+	}
+
+	if (!action || !devname || !subsystem || strcmp(subsystem, "input"))
+		return;
+	if (strncmp(devname, "input/event", 11) != 0)
+		return;
+	snprintf(path, sizeof(path), "/dev/%s", devname);
+
+	if (strcmp(action, "add") == 0) {
+		device_add(path);
+	} else if (strcmp(action, "remove") == 0) {
+		dev = device_find(path);
+		if (dev)
+			device_remove(dev);
+	}
+}
+
+void devices_init(char *dev_list, void (*process)(struct source *src))
+{
+	struct sockaddr_nl addr;
+	struct evdev *dev;
+	char *ptr, *next_ptr;
+
+	process_device = process;
+
+	next_ptr = dev_list[0] ? dev_list : NULL;
+	while (next_ptr) {
+		ptr = next_ptr;
+		next_ptr = strchr(ptr, ',');
+		if (next_ptr) {
+			*next_ptr = '\0';
+			next_ptr++;
+			if (*next_ptr == '\0')
+				next_ptr = NULL;
+		}
+		dev = device_new(ptr, 1);
+		device_open(dev);
+	}
+
+	uevent_src.fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+			       NETLINK_KOBJECT_UEVENT);
+	if (uevent_src.fd == -1)
+		die("Could not open uevent socket: %s\n", strerror(errno));
+
+	memset(&addr, 0, sizeof(addr));
+	addr.nl_family = AF_NETLINK;
+	addr.nl_groups = 1;
+	if (bind(uevent_src.fd, (struct sockaddr *)&addr, sizeof(addr)))
+		die("Could not bind uevent socket: %s\n", strerror(errno));
+	if (loop_add(&uevent_src, EPOLLIN))
+		die("Could not listen to uevents\n");
+
+	devices_scan();
+}
+
+static void caps_add(unsigned long *caps, int fd, int type, size_t len)
+{
+	unsigned long bits[NLONGS(KEY_CNT)];
+	size_t i;
+
+	memset(bits, 0, sizeof(bits));
+	if (ioctl(fd, EVIOCGBIT(type, len), bits) < 0)
+		return;
+	for (i = 0; i < len / sizeof(long); i++)
+		caps[i] |= bits[i];
+}
+
+/* Add up capabilities of open devices. Returns -1 if there may be others
+ * coming later: static ones which are gone now or hotplugged ones
+ */
+int devices_caps(struct caps *caps)
+{
+	struct evdev *dev;
+	int res = config->rules_cnt ? -1 : 0;
+
+	for (dev = evdevs; dev; dev = dev->next) {
+		if (dev->src.fd == -1) {
+			res = -1;
+			continue;
+		}
+		caps_add(caps->ev, dev->src.fd, 0, sizeof(caps->ev));
+		caps_add(caps->key, dev->src.fd, EV_KEY, sizeof(caps->key));
+		caps_add(caps->msc, dev->src.fd, EV_MSC, sizeof(caps->msc));
+		caps_add(caps->sw, dev->src.fd, EV_SW, sizeof(caps->sw));
+	}
+
+	return res;
+}
+
+/* Keys held on any of the devices */
+void devices_keys(unsigned long *keys)
+{
+	struct evdev *dev;
+	size_t i;
+
+	memset(keys, 0, NLONGS(KEY_CNT) * sizeof(*keys));
+	for (dev = evdevs; dev; dev = dev->next) {
+		if (dev->src.fd == -1)
+			continue;
+		for (i = 0; i < NLONGS(KEY_CNT); i++)
+			keys[i] |= dev->keys[i];
+	}
+}
+
+void devices_close(void)
+{
+	struct evdev *dev;
+
+	while (evdevs) {
+		dev = evdevs;
+		evdevs = dev->next;
+		if (dev->src.fd != -1) {
+			if (device_stop)
+				device_stop(dev);
+			if (ioctl(dev->src.fd, EVIOCGRAB, 0))
+				warn("Could not ungrab %s: %s\n", dev->path,
+				     strerror(errno));
+			close(dev->src.fd);
+		}
+		free(dev);
+	}
+	evdev_cnt = 0;
+	devices_reap();
+	close(uevent_src.fd);
+}
@@ -0,0 +1,84 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef __DEVICES_H
+#define __DEVICES_H
+
+#include <limits.h>
+#include <linux/input.h>
+
+#include "mouse-emul.h"
+
+#define BITS_PER_LONG (sizeof(long) * 8)
+#define NLONGS(x) (((x) + BITS_PER_LONG - 1) / BITS_PER_LONG)
+#define test_bit(bit, array) \
+	(((array)[(bit) / BITS_PER_LONG] >> ((bit) % BITS_PER_LONG)) & 1)
+#define set_bit(bit, array) \
+	((array)[(bit) / BITS_PER_LONG] |= 1UL << ((bit) % BITS_PER_LONG))
+#define clear_bit(bit, array) \
+	((array)[(bit) / BITS_PER_LONG] &= ~(1UL << ((bit) % BITS_PER_LONG)))
+
+/* What grabbed devices can send */
+struct caps {
+	unsigned long ev[NLONGS(EV_CNT)];
+	unsigned long key[NLONGS(KEY_CNT)];
+	unsigned long msc[NLONGS(MSC_CNT)];
+	unsigned long sw[NLONGS(SW_CNT)];
+};
+
+struct reader;
+struct uring_read;
+
+struct evdev {
+	/* src.fd is -1 while the device is gone */
+	struct source src;
+	char path[PATH_MAX];
+	/* Given with -d, kept in the list to be reopened when it comes back */
+	int is_static;
+	/* Keys currently held on this device, released if it goes away */
+	unsigned long keys[NLONGS(KEY_CNT)];
+	/* Reader thread in threaded mode */
+	struct reader *reader;
+	/* Read posted on it in io_uring mode */
+	struct uring_read *uring;
+	/* Read budget was used up with events left, see process_device() */
+	int pending;
+	struct evdev *next;
+};
+
+extern struct evdev *evdevs;
+/* Devices currently open, static ones may be in the list closed */
+extern int evdev_cnt;
+
+/* Called before a device is closed, i.e. to release its held keys */
+extern void (*device_removed)(struct evdev *dev);
+/* How an opened device gets read, the event loop is used if not set */
+extern int (*device_start)(struct evdev *dev);
+extern void (*device_stop)(struct evdev *dev);
+
+void devices_init(char *dev_list, void (*process)(struct source *src));
+void devices_scan(void);
+void devices_reap(void);
+void devices_close(void);
+int devices_caps(struct caps *caps);
+void devices_keys(unsigned long *keys);
+void device_remove(struct evdev *dev);
+
+#endif
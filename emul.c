@@ -0,0 +1,821 @@
+/*  
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/time.h>
+#include <sys/timerfd.h>
+
+#include <linux/input.h>
+
+#include "devices.h"
+#include "emul.h"
+#include "mouse-emul.h"
+#include "options.h"
+#include "stats.h"
+
+/* Events are collected per device and handed to the sink at once (a single
+ * write() for uinput) when the whole read batch is processed or the buffer
+ * fills up
+ */
+int flush_events(struct uoutput *out)
+{
+	int cnt = out->cnt;
+
+	if (!cnt)
+		return 0;
+
+	stats.events_out += cnt;
+	out->sink->total += cnt;
+	out->cnt = 0;
+
+	return out->sink->write(out->sink, out->ev, cnt);
+}
+
+int send_event(struct uoutput *out, __u16 type, __u16 code, __s32 value)
+{
+	struct input_event *event;
+
+	if (out->cnt == OUT_BUF_SIZE && flush_events(out))
+		return -1;
+
+	event = &out->ev[out->cnt++];
+	memset(event, 0, sizeof(*event));
+	event->type = type;
+	event->code = code;
+	event->value = value;
+
+	return 0;
+}
+
+/* Preassembled events go out as they are, after whatever is buffered */
+static int send_frame(struct uoutput *out, const struct input_event *ev,
+		      int cnt)
+{
+	if (flush_events(out))
+		return -1;
+
+	stats.events_out += cnt;
+	out->sink->total += cnt;
+
+	return out->sink->write(out->sink, ev, cnt);
+}
+
+static void motion_arm(struct emul *emul, int on)
+{
+	struct itimerspec its;
+	long period = 1000000000L / config->motion_rate;
+
+	if (emul->motion_fd == -1)
+		return;
+
+	memset(&its, 0, sizeof(its));
+	if (on) {
+		its.it_interval.tv_sec = period / 1000000000L;
+		its.it_interval.tv_nsec = period % 1000000000L;
+		its.it_value = its.it_interval;
+	}
+	if (timerfd_settime(emul->motion_fd, 0, &its, NULL))
+		warn("Could not set motion timer: %s\n", strerror(errno));
+}
+
+/* Round to the nearest pixel (or wheel unit), carrying the remainder over to
+ * next tick
+ */
+static int32_t take_pixels(int64_t *acc)
+{
+	int32_t px;
+
+	if (*acc >= 0)
+		px = (*acc + FIXED_ONE / 2) >> FIXED_SHIFT;
+	else
+		px = -((-*acc + FIXED_ONE / 2) >> FIXED_SHIFT);
+	*acc -= px * FIXED_ONE;
+
+	return px;
+}
+
+/* Position on an acceleration ramp which started at start */
+static int ramp_index(const struct timeval *now, const struct timeval *start,
+		      int accel_time)
+{
+	long elapsed;
+
+	elapsed = (now->tv_sec - start->tv_sec) * 1000 +
+		(now->tv_usec - start->tv_usec) / 1000;
+	if (elapsed < 0)
+		elapsed = 0;
+	if (elapsed >= accel_time)
+		return ACCEL_TABLE_SIZE - 1;
+
+	return elapsed * (ACCEL_TABLE_SIZE - 1) / accel_time;
+}
+
+static void move_tick(struct emul *emul, const struct timeval *now, int ticks)
+{
+	int dx, dy, idx;
+	int32_t px, py;
+
+	dx = !!(emul->held & DIR_RIGHT) - !!(emul->held & DIR_LEFT);
+	dy = !!(emul->held & DIR_DOWN) - !!(emul->held & DIR_UP);
+	idx = ramp_index(now, &emul->motion_start, config->accel_time);
+
+	emul->acc_x += (int64_t)dx * ticks * config->accel_table[idx];
+	emul->acc_y += (int64_t)dy * ticks * config->accel_table[idx];
+	px = take_pixels(&emul->acc_x);
+	py = take_pixels(&emul->acc_y);
+
+	if (px)
+		send_event(&emul->mouse, EV_REL, REL_X, px);
+	if (py)
+		send_event(&emul->mouse, EV_REL, REL_Y, py);
+	if (px || py)
+		send_event(&emul->mouse, EV_SYN, SYN_REPORT, 0);
+}
+
+/* Hi-res value goes along with whole notches for older clients, partial
+ * notches are carried over
+ */
+static int send_wheel(struct emul *emul, __u16 code, __u16 hi_res_code,
+		      int32_t units, int32_t *rem)
+{
+	int32_t notches;
+
+	if (!units)
+		return 0;
+
+	*rem += units;
+	notches = *rem / WHEEL_NOTCH;
+	*rem -= notches * WHEEL_NOTCH;
+
+	send_event(&emul->mouse, EV_REL, hi_res_code, units);
+	if (notches)
+		send_event(&emul->mouse, EV_REL, code, notches);
+
+	return 1;
+}
+
+static void scroll_send(struct emul *emul, int32_t v, int32_t h)
+{
+	int sent;
+
+	/* Wheel up and right are positive */
+	sent = send_wheel(emul, REL_WHEEL, REL_WHEEL_HI_RES, v, &emul->wheel_rem);
+	sent |= send_wheel(emul, REL_HWHEEL, REL_HWHEEL_HI_RES, h,
+			   &emul->hwheel_rem);
+	if (sent)
+		send_event(&emul->mouse, EV_SYN, SYN_REPORT, 0);
+}
+
+/* Accumulated every tick, but sent only every scroll_every ticks */
+static void scroll_tick(struct emul *emul, const struct timeval *now, int ticks)
+{
+	int dv, dh, idx;
+
+	dv = !!(emul->scrolling & DIR_UP) - !!(emul->scrolling & DIR_DOWN);
+	dh = !!(emul->scrolling & DIR_RIGHT) - !!(emul->scrolling & DIR_LEFT);
+	idx = ramp_index(now, &emul->scroll_start, config->scroll_accel_time);
+
+	emul->acc_wheel += (int64_t)dv * ticks * config->scroll_table[idx];
+	emul->acc_hwheel += (int64_t)dh * ticks * config->scroll_table[idx];
+
+	emul->scroll_ticks += ticks;
+	if (emul->scroll_ticks < config->scroll_every)
+		return;
+	emul->scroll_ticks = 0;
+
+	scroll_send(emul, take_pixels(&emul->acc_wheel),
+		    take_pixels(&emul->acc_hwheel));
+}
+
+void motion_tick(struct emul *emul, const struct timeval *now, int ticks)
+{
+	if (emul->held)
+		move_tick(emul, now, ticks);
+	if (emul->scrolling)
+		scroll_tick(emul, now, ticks);
+}
+
+int motion_active(struct emul *emul)
+{
+	return emul->held || emul->scrolling;
+}
+
+void motion_stop(struct emul *emul)
+{
+	emul->held = emul->scrolling = 0;
+	emul->acc_x = emul->acc_y = 0;
+	emul->acc_wheel = emul->acc_hwheel = 0;
+	emul->wheel_rem = emul->hwheel_rem = 0;
+	motion_arm(emul, 0);
+}
+
+static void macro_arm(struct emul *emul)
+{
+	struct itimerspec its;
+
+	if (emul->macro_fd == -1)
+		return;
+
+	memset(&its, 0, sizeof(its));
+	if (emul->macro_left) {
+		its.it_value.tv_sec = emul->macro_due.tv_sec;
+		its.it_value.tv_nsec = emul->macro_due.tv_usec * 1000;
+	}
+	if (timerfd_settime(emul->macro_fd, TFD_TIMER_ABSTIME, &its, NULL))
+		warn("Could not set macro timer: %s\n", strerror(errno));
+}
+
+static void macro_wait(struct emul *emul, int ms)
+{
+	struct timeval delay;
+
+	delay.tv_sec = ms / 1000;
+	delay.tv_usec = ms % 1000 * 1000;
+	timeradd(&emul->macro_due, &delay, &emul->macro_due);
+}
+
+static void macro_emit(struct emul *emul)
+{
+	const struct macro_frame *frame = &config->macro_frames[emul->macro_next];
+
+	send_frame(frame->mouse ? &emul->mouse : &emul->kbd,
+		   &config->macro_events[frame->first], frame->cnt);
+	emul->macro_next++;
+	emul->macro_left--;
+
+	/* Delays add up from when the previous frame was due */
+	if (emul->macro_left)
+		macro_wait(emul, frame[1].delay);
+}
+
+/* NULL if no macro is running */
+const struct timeval *macro_due(struct emul *emul)
+{
+	return emul->macro_left ? &emul->macro_due : NULL;
+}
+
+/* Send frames which are due, the timer is set for the next one */
+void macro_tick(struct emul *emul, const struct timeval *now)
+{
+	while (emul->macro_left && !timercmp(now, &emul->macro_due, <))
+		macro_emit(emul);
+	macro_arm(emul);
+}
+
+/* Send the rest right away, i.e. before config goes away */
+void macro_finish(struct emul *emul)
+{
+	if (!emul->macro_left)
+		return;
+
+	while (emul->macro_left)
+		macro_emit(emul);
+	macro_arm(emul);
+}
+
+static void macro_start(struct emul *emul, int idx, const struct timeval *now)
+{
+	const struct macro *macro = &config->macros[idx];
+
+	/* One at a time, so keys pressed by the previous one get released */
+	macro_finish(emul);
+
+	stats.macros++;
+	emul->macro_next = macro->first_frame;
+	emul->macro_left = macro->frame_cnt;
+	emul->macro_due = *now;
+	macro_wait(emul, config->macro_frames[emul->macro_next].delay);
+	macro_tick(emul, now);
+}
+
+/* Pressed/released bit in a mask of held keys, autorepeat is ignored as
+ * motion is driven by motion timer. Returns bits which were held before
+ */
+static unsigned int update_held(unsigned int *mask, struct input_event *evt,
+				unsigned int dir)
+{
+	unsigned int was_held = *mask;
+
+	if (evt->value == 0)
+		*mask &= ~dir;
+	else if (evt->value == 1)
+		*mask |= dir;
+
+	return was_held;
+}
+
+static void process_direction(struct emul *emul, struct input_event *evt,
+			      unsigned int dir)
+{
+	int was_active = motion_active(emul);
+	unsigned int was_held = update_held(&emul->held, evt, dir);
+
+	if (emul->held && !was_held) {
+		/* Move right away, the timer takes over from here */
+		emul->motion_start = evt->time;
+		emul->acc_x = emul->acc_y = 0;
+		move_tick(emul, &evt->time, 1);
+	} else if (!emul->held && was_held)
+		emul->acc_x = emul->acc_y = 0;
+
+	if (motion_active(emul) != was_active)
+		motion_arm(emul, !was_active);
+}
+
+static void process_scroll(struct emul *emul, struct input_event *evt,
+			   unsigned int dir)
+{
+	int was_active = motion_active(emul);
+	unsigned int was_held = update_held(&emul->scrolling, evt, dir);
+
+	if (emul->scrolling && !was_held) {
+		/* A notch right away, as a wheel click would do */
+		emul->scroll_start = evt->time;
+		emul->acc_wheel = emul->acc_hwheel = 0;
+		emul->wheel_rem = emul->hwheel_rem = 0;
+		emul->scroll_ticks = 0;
+		scroll_send(emul,
+			    (!!(dir & DIR_UP) - !!(dir & DIR_DOWN)) * WHEEL_NOTCH,
+			    (!!(dir & DIR_RIGHT) - !!(dir & DIR_LEFT)) * WHEEL_NOTCH);
+	}
+
+	if (motion_active(emul) != was_active)
+		motion_arm(emul, !was_active);
+}
+
+/* Narrow the area down to a cell and warp the pointer to its middle. The
+ * first key after anything else starts from the whole screen
+ */
+static void process_grid(struct emul *emul, struct input_event *evt, int cell)
+{
+	int col = cell % GRID_SIZE, row = cell / GRID_SIZE;
+	int x, y;
+
+	if (evt->value != 1)
+		return;
+
+	if (!emul->grid_w) {
+		emul->grid_x = emul->grid_y = 0;
+		emul->grid_w = config->screen_width;
+		emul->grid_h = config->screen_height;
+	}
+
+	/* Cells cover the area without gaps, down to a pixel */
+	x = emul->grid_x + emul->grid_w * col / GRID_SIZE;
+	y = emul->grid_y + emul->grid_h * row / GRID_SIZE;
+	if (emul->grid_w >= GRID_SIZE)
+		emul->grid_w = emul->grid_x + emul->grid_w * (col + 1) / GRID_SIZE - x;
+	if (emul->grid_h >= GRID_SIZE)
+		emul->grid_h = emul->grid_y + emul->grid_h * (row + 1) / GRID_SIZE - y;
+	emul->grid_x = x;
+	emul->grid_y = y;
+
+	send_event(&emul->abs, EV_ABS, ABS_X, emul->grid_x + emul->grid_w / 2);
+	send_event(&emul->abs, EV_ABS, ABS_Y, emul->grid_y + emul->grid_h / 2);
+	send_event(&emul->abs, EV_SYN, SYN_REPORT, 0);
+}
+
+static void layers_update(struct emul *emul)
+{
+	if (emul->layer_hold)
+		emul->layer_active = emul->layer_hold;
+	else if (emul->layer_oneshot)
+		emul->layer_active = emul->layer_oneshot;
+	else
+		emul->layer_active = emul->layer;
+}
+
+/* Back to the base layer, i.e. when layers of another config come in */
+void layers_reset(struct emul *emul)
+{
+	emul->layer = emul->layer_hold = emul->layer_oneshot = 0;
+	emul->layer_active = 0;
+	memset(emul->key_layer, 0, sizeof(emul->key_layer));
+}
+
+/* Let go of what held keys are bound to, in the layer they were pressed
+ * in: their release would be looked up in the new config. I.e. before
+ * config goes away
+ */
+void keys_finish(struct emul *emul, const unsigned long *keys)
+{
+	const struct action *act;
+	int code;
+
+	for (code = 0; code < KEY_CNT; code++) {
+		if (!test_bit(code, keys))
+			continue;
+		act = &config->layers[emul->key_layer[code]][EVENT_KEY][code];
+		emul->key_layer[code] = 0;
+		if (act->kind == ACTION_BUTTON) {
+			send_event(&emul->mouse, act->type, act->code, 0);
+			send_event(&emul->mouse, EV_SYN, SYN_REPORT, 0);
+		} else if (act->kind == ACTION_REMAP) {
+			send_event(&emul->kbd, act->type, act->code, 0);
+			send_event(&emul->kbd, EV_SYN, SYN_REPORT, 0);
+		}
+	}
+}
+
+static int is_layer_key(const struct action *act)
+{
+	return act->kind == ACTION_LAYER_HOLD ||
+		act->kind == ACTION_LAYER_TOGGLE ||
+		act->kind == ACTION_LAYER_ONESHOT;
+}
+
+/* Key presses are looked up in the active layer, releases and autorepeat
+ * in the one the key was pressed in
+ */
+static const struct action *lookup(struct emul *emul,
+				   const struct input_event *evt)
+{
+	int layer = emul->layer_active;
+
+	if (evt->type == EV_KEY && evt->value != 1)
+		layer = emul->key_layer[evt->code];
+
+	return &config->layers[layer][type_linux_to_local[evt->type]][evt->code];
+}
+
+/* Layer keys are swallowed, with emulation on or off */
+static void process_layer_key(struct emul *emul, struct input_event *evt,
+			      const struct action *act)
+{
+	switch (act->kind) {
+	case ACTION_LAYER_HOLD:
+		if (evt->value == 1)
+			emul->layer_hold = act->arg;
+		else if (evt->value == 0 && emul->layer_hold == act->arg)
+			emul->layer_hold = 0;
+		break;
+	case ACTION_LAYER_TOGGLE:
+		if (evt->value == 1)
+			emul->layer = emul->layer == act->arg ? 0 : act->arg;
+		break;
+	case ACTION_LAYER_ONESHOT:
+		if (evt->value == 1)
+			emul->layer_oneshot = act->arg;
+		break;
+	}
+	layers_update(emul);
+}
+
+static uint64_t timeval_ms(const struct timeval *tv)
+{
+	return tv->tv_sec * 1000ULL + tv->tv_usec / 1000;
+}
+
+/* timer_fd is only set when the wheel needs a turn earlier than it goes
+ * off anyway, one going off early just sets it again
+ */
+static void timers_arm(struct emul *emul)
+{
+	struct itimerspec its;
+	uint64_t next;
+
+	if (emul->timer_fd == -1 || !emul->timers.cnt)
+		return;
+
+	next = wheel_next(&emul->timers);
+	if (emul->timer_armed && emul->timer_armed <= next)
+		return;
+
+	memset(&its, 0, sizeof(its));
+	its.it_value.tv_sec = next / 1000;
+	its.it_value.tv_nsec = next % 1000 * 1000000;
+	if (timerfd_settime(emul->timer_fd, TFD_TIMER_ABSTIME, &its, NULL))
+		warn("Could not set tap-hold timer: %s\n", strerror(errno));
+	else
+		emul->timer_armed = next;
+}
+
+/* timer_fd went off, or the caller drives time itself */
+void timers_tick(struct emul *emul, const struct timeval *now)
+{
+	emul->timer_armed = 0;
+	wheel_run(&emul->timers, timeval_ms(now));
+	timers_arm(emul);
+}
+
+static void tap_hold_send(struct emul *emul, const struct tap_hold *th,
+			  int value)
+{
+	switch (th->hold_kind) {
+	case TAP_HOLD_LAYER:
+		if (value)
+			emul->layer_hold = th->hold;
+		else if (emul->layer_hold == th->hold)
+			emul->layer_hold = 0;
+		layers_update(emul);
+		break;
+	case TAP_HOLD_BUTTON:
+		stats.mouse++;
+		send_event(&emul->mouse, EV_KEY, th->hold, value);
+		send_event(&emul->mouse, EV_SYN, SYN_REPORT, 0);
+		break;
+	default:
+		send_event(&emul->kbd, EV_KEY, th->hold, value);
+		send_event(&emul->kbd, EV_SYN, SYN_REPORT, 0);
+		break;
+	}
+}
+
+/* Pending key becomes held, when it times out or another key is pressed */
+static void tap_hold_hold(struct tap_hold_key *key)
+{
+	struct emul *emul = key->emul;
+
+	timer_del(&emul->timers, &key->timer);
+	key->state = TAP_HOLD_HELD;
+	emul->tap_holds_pending--;
+	tap_hold_send(emul, &config->tap_holds[key - emul->tap_holds], 1);
+}
+
+static void tap_hold_expired(struct timer *timer)
+{
+	tap_hold_hold((struct tap_hold_key *)timer);
+}
+
+/* Another key goes down, so pending keys are meant to be held with it */
+static void tap_hold_resolve(struct emul *emul)
+{
+	int i;
+
+	for (i = 0; i < config->tap_holds_cnt && emul->tap_holds_pending; i++) {
+		if (emul->tap_holds[i].state == TAP_HOLD_PENDING)
+			tap_hold_hold(&emul->tap_holds[i]);
+	}
+}
+
+/* Autorepeat is swallowed, hold keys are modifiers and buttons */
+static void process_tap_hold(struct emul *emul, struct input_event *evt,
+			     int idx)
+{
+	const struct tap_hold *th = &config->tap_holds[idx];
+	struct tap_hold_key *key = &emul->tap_holds[idx];
+
+	if (evt->value == 1 && key->state == TAP_HOLD_IDLE) {
+		key->state = TAP_HOLD_PENDING;
+		emul->tap_holds_pending++;
+		/* An empty wheel isn't run, its time may be far behind */
+		wheel_run(&emul->timers, timeval_ms(&evt->time));
+		timer_add(&emul->timers, &key->timer, timeval_ms(&evt->time) +
+			  (th->timeout ? th->timeout : config->tap_hold_timeout));
+		timers_arm(emul);
+	} else if (evt->value == 0 && key->state == TAP_HOLD_PENDING) {
+		timer_del(&emul->timers, &key->timer);
+		key->state = TAP_HOLD_IDLE;
+		emul->tap_holds_pending--;
+		send_event(&emul->kbd, EV_KEY, th->tap, 1);
+		send_event(&emul->kbd, EV_SYN, SYN_REPORT, 0);
+		send_event(&emul->kbd, EV_KEY, th->tap, 0);
+		send_event(&emul->kbd, EV_SYN, SYN_REPORT, 0);
+	} else if (evt->value == 0 && key->state == TAP_HOLD_HELD) {
+		key->state = TAP_HOLD_IDLE;
+		tap_hold_send(emul, th, 0);
+	}
+}
+
+/* Let go of held keys and forget pending ones, i.e. before config goes
+ * away
+ */
+void tap_hold_finish(struct emul *emul)
+{
+	struct tap_hold_key *key;
+	int i;
+
+	for (i = 0; i < TAP_HOLDS_MAX; i++) {
+		key = &emul->tap_holds[i];
+		if (key->state == TAP_HOLD_HELD)
+			tap_hold_send(emul, &config->tap_holds[i], 0);
+		timer_del(&emul->timers, &key->timer);
+		key->state = TAP_HOLD_IDLE;
+	}
+	emul->tap_holds_pending = 0;
+}
+
+void process_event(struct emul *emul, struct input_event *evt)
+{
+	const struct action *act;
+
+	/* Timeouts up to this event go first, whether timer_fd has gone off
+	 * yet or not
+	 */
+	if (emul->timers.cnt)
+		wheel_run(&emul->timers, timeval_ms(&evt->time));
+	if (emul->tap_holds_pending && evt->type == EV_KEY && evt->value == 1)
+		tap_hold_resolve(emul);
+
+	act = lookup(emul, evt);
+	if (evt->type == EV_KEY) {
+		if (evt->value == 1)
+			emul->key_layer[evt->code] = emul->layer_active;
+		else if (evt->value == 0)
+			emul->key_layer[evt->code] = 0;
+		/* One-shot layer is over with the next key pressed */
+		if (evt->value == 1 && emul->layer_oneshot && !is_layer_key(act)) {
+			emul->layer_oneshot = 0;
+			layers_update(emul);
+		}
+	}
+
+	switch (act->kind) {
+	case ACTION_TOGGLE:
+		/* We're grabbing toggle key, no need to emit event for it */
+		if (evt->value == 1) {
+			emul->enabled ^= 1;
+			return;
+		}
+		break;
+	case ACTION_MOD:
+		emul->tmp_enabled = (evt->value == 1);
+		break;
+	case ACTION_MACRO:
+		/* Run on press whether emulation is on or not, release and
+		 * autorepeat of the key are swallowed
+		 */
+		if (evt->value == 1)
+			macro_start(emul, act->arg, &evt->time);
+		return;
+	case ACTION_LAYER_HOLD:
+	case ACTION_LAYER_TOGGLE:
+	case ACTION_LAYER_ONESHOT:
+		process_layer_key(emul, evt, act);
+		return;
+	case ACTION_TAP_HOLD:
+		process_tap_hold(emul, evt, act->arg);
+		return;
+	}
+
+	/* No emulation enabled? Passthrough event, unless it's remapped in
+	 * a layer
+	 */
+	if (!emul->enabled && !emul->tmp_enabled && !act->layer) {
+		stats.passthrough++;
+		if (motion_active(emul))
+			motion_stop(emul);
+		send_event(&emul->kbd, EV_KEY, evt->code, evt->value);
+		send_event(&emul->kbd, EV_SYN, SYN_REPORT, 0);
+		return;
+	}
+
+	/* Relative motion and clicks finish with the grid */
+	if (act->kind != ACTION_GRID && evt->value == 1)
+		emul->grid_w = 0;
+
+	switch (act->kind) {
+	case ACTION_GRID:
+		stats.mouse++;
+		process_grid(emul, evt, act->arg);
+		break;
+	case ACTION_MOVE:
+		stats.mouse++;
+		process_direction(emul, evt, act->arg);
+		break;
+	case ACTION_SCROLL:
+		stats.mouse++;
+		process_scroll(emul, evt, act->arg);
+		break;
+	case ACTION_BUTTON:
+		stats.mouse++;
+		send_event(&emul->mouse, act->type, act->code, evt->value);
+		send_event(&emul->mouse, EV_SYN, SYN_REPORT, 0);
+		break;
+	default:
+		if (act->kind == ACTION_REMAP)
+			stats.remapped++;
+		else
+			stats.passthrough++;
+		send_event(&emul->kbd, act->type, act->code, evt->value);
+		send_event(&emul->kbd, EV_SYN, SYN_REPORT, 0);
+		break;
+	}
+}
+
+/* Keys which do something even with emulation off */
+static int is_special(struct emul *emul, const struct input_event *evt)
+{
+	const struct action *act;
+
+	if ((evt->type != EV_KEY && evt->type != EV_SW) || evt->code >= KEY_CNT)
+		return 0;
+
+	/* Any key press settles pending tap-hold keys, and ends a one-shot
+	 * layer
+	 */
+	if ((emul->tap_holds_pending || emul->layer_oneshot) &&
+	    evt->type == EV_KEY && evt->value == 1)
+		return 1;
+
+	act = lookup(emul, evt);
+	return act->kind == ACTION_TOGGLE || act->kind == ACTION_MOD ||
+		act->kind == ACTION_MACRO || act->kind == ACTION_TAP_HOLD ||
+		is_layer_key(act) || act->layer;
+}
+
+/* Events go to kbd as they were read, in a single write */
+static void passthrough(struct emul *emul, const struct input_event *ev,
+			int cnt)
+{
+	if (!cnt)
+		return;
+
+	if (motion_active(emul))
+		motion_stop(emul);
+	send_frame(&emul->kbd, ev, cnt);
+}
+
+/* Read batch from a device. With emulation off it's passed through as is,
+ * MSC_SCAN and frames included, only special keys (and ones remapped in the
+ * active layer) are spliced out and processed. Otherwise keys and switches
+ * are processed one by one
+ */
+void process_events(struct emul *emul, struct input_event *ev, int cnt)
+{
+	int i, start = 0;
+
+	for (i = 0; i < cnt; i++) {
+		if (emul->enabled || emul->tmp_enabled) {
+			if (ev[i].type == EV_KEY || ev[i].type == EV_SW)
+				process_event(emul, &ev[i]);
+			start = i + 1;
+			continue;
+		}
+		if (!is_special(emul, &ev[i])) {
+			if (ev[i].type == EV_KEY)
+				stats.passthrough++;
+			continue;
+		}
+		passthrough(emul, ev + start, i - start);
+		process_event(emul, &ev[i]);
+		start = i + 1;
+	}
+	passthrough(emul, ev + start, cnt - start);
+
+	/* Rest of the frame comes with the next read, don't leave this part
+	 * hanging for events of other devices to join
+	 */
+	if (start < cnt && ev[cnt - 1].type != EV_SYN)
+		send_event(&emul->kbd, EV_SYN, SYN_REPORT, 0);
+}
+
+void emul_init(struct emul *emul, struct sink *kbd, struct sink *mouse,
+	       struct sink *abs, int motion_fd, int macro_fd, int timer_fd)
+{
+	int i;
+
+	memset(emul, 0, sizeof(*emul));
+	emul->kbd.sink = kbd;
+	emul->mouse.sink = mouse;
+	emul->abs.sink = abs;
+	emul->motion_fd = motion_fd;
+	emul->macro_fd = macro_fd;
+	emul->timer_fd = timer_fd;
+	wheel_init(&emul->timers);
+	for (i = 0; i < TAP_HOLDS_MAX; i++) {
+		emul->tap_holds[i].timer.fn = tap_hold_expired;
+		emul->tap_holds[i].emul = emul;
+	}
+}
+
+/* Back to the startup state, i.e. between replay runs */
+void emul_reset(struct emul *emul)
+{
+	emul->enabled = emul->tmp_enabled = 0;
+	emul->grid_w = 0;
+	tap_hold_finish(emul);
+	layers_reset(emul);
+	motion_stop(emul);
+	emul->macro_left = 0;
+	macro_arm(emul);
+	emul->kbd.cnt = emul->mouse.cnt = emul->abs.cnt = 0;
+}
+
+void emul_flush(struct emul *emul)
+{
+	flush_events(&emul->kbd);
+	flush_events(&emul->mouse);
+	flush_events(&emul->abs);
+}
@@ -0,0 +1,138 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef __EMUL_H
+#define __EMUL_H
+
+#include <stdint.h>
+#include <sys/time.h>
+#include <linux/input.h>
+
+#include "options.h"
+#include "sink.h"
+#include "wheel.h"
+
+#ifndef REL_WHEEL_HI_RES
+#define REL_WHEEL_HI_RES 0x0b
+#define REL_HWHEEL_HI_RES 0x0c
+#endif
+
+/* Enough for a full read batch of key events with their SYN_REPORTs */
+#define OUT_BUF_SIZE 256
+
+/* Events for one emulated device, collected until flush_events() */
+struct uoutput {
+	struct sink *sink;
+	int cnt;
+	struct input_event ev[OUT_BUF_SIZE];
+};
+
+enum tap_hold_states {
+	TAP_HOLD_IDLE = 0,
+	TAP_HOLD_PENDING,
+	TAP_HOLD_HELD,
+};
+
+/* Tap-hold key, pending until it's released (a tap) or times out */
+struct tap_hold_key {
+	/* First, timer callbacks get this */
+	struct timer timer;
+	struct emul *emul;
+	int state;
+};
+
+/* State of one emulator instance */
+struct emul {
+	/* abs is the absolute pointer for grid warps */
+	struct uoutput kbd, mouse, abs;
+
+	int enabled, tmp_enabled;
+
+	/* Layer toggled on (0 is the base one), and held and one-shot layers
+	 * on top of it, 0 if none. Events are looked up in layer_active, the
+	 * topmost of them
+	 */
+	int layer, layer_hold, layer_oneshot, layer_active;
+	/* Layer each key was pressed in, so it's released as what it was
+	 * pressed as
+	 */
+	uint8_t key_layer[KEY_CNT];
+
+	/* Motion timer, -1 if ticks are driven by the caller (i.e. replay) */
+	int motion_fd;
+	/* Bits of direction keys being held */
+	unsigned int held;
+	/* Time of the key-down that started motion, CLOCK_MONOTONIC */
+	struct timeval motion_start;
+	/* Sub-pixel remainders, fixed point */
+	int64_t acc_x, acc_y;
+
+	/* Scroll keys being held, same bits, driven by motion timer too */
+	unsigned int scrolling;
+	struct timeval scroll_start;
+	/* Hi-res wheel units not sent yet, fixed point */
+	int64_t acc_wheel, acc_hwheel;
+	/* Hi-res units sent, but not making a whole notch yet */
+	int32_t wheel_rem, hwheel_rem;
+	int scroll_ticks;
+
+	/* Screen area the next grid key picks a cell of, grid_w is 0 if it's
+	 * the whole screen again
+	 */
+	int grid_x, grid_y, grid_w, grid_h;
+
+	/* Macro timer, -1 if the caller runs macro_tick() itself */
+	int macro_fd;
+	/* Next frame of the running macro and number of frames left */
+	int macro_next, macro_left;
+	/* When the next frame is due, CLOCK_MONOTONIC */
+	struct timeval macro_due;
+
+	/* Timeouts of tap-hold keys, in ms of CLOCK_MONOTONIC */
+	struct wheel timers;
+	/* Timer the wheel runs off, -1 if the caller runs timers_tick() */
+	int timer_fd;
+	/* When timer_fd goes off, 0 if it's not set */
+	uint64_t timer_armed;
+	struct tap_hold_key tap_holds[TAP_HOLDS_MAX];
+	int tap_holds_pending;
+};
+
+int send_event(struct uoutput *out, __u16 type, __u16 code, __s32 value);
+int flush_events(struct uoutput *out);
+
+void emul_init(struct emul *emul, struct sink *kbd, struct sink *mouse,
+	       struct sink *abs, int motion_fd, int macro_fd, int timer_fd);
+void emul_reset(struct emul *emul);
+void layers_reset(struct emul *emul);
+void keys_finish(struct emul *emul, const unsigned long *keys);
+void emul_flush(struct emul *emul);
+void process_event(struct emul *emul, struct input_event *evt);
+void process_events(struct emul *emul, struct input_event *ev, int cnt);
+int motion_active(struct emul *emul);
+void motion_tick(struct emul *emul, const struct timeval *now, int ticks);
+void motion_stop(struct emul *emul);
+const struct timeval *macro_due(struct emul *emul);
+void macro_tick(struct emul *emul, const struct timeval *now);
+void macro_finish(struct emul *emul);
+void timers_tick(struct emul *emul, const struct timeval *now);
+void tap_hold_finish(struct emul *emul);
+
+#endif
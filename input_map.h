@@ -11,529 +11,1958 @@
  *  (at your option) any later version.
  */
 
-struct uint_str_tuple linux_input_map[] = {
-{"BTN_MISC", 0x100},
-{"BTN_0", 0x100},
-{"BTN_1", 0x101},
-{"BTN_2", 0x102},
-{"BTN_3", 0x103},
-{"BTN_4", 0x104},
-{"BTN_5", 0x105},
-{"BTN_6", 0x106},
-{"BTN_7", 0x107},
-{"BTN_8", 0x108},
-{"BTN_9", 0x109},
-{"BTN_MOUSE", 0x110},
-{"BTN_LEFT", 0x110},
-{"BTN_RIGHT", 0x111},
-{"BTN_MIDDLE", 0x112},
-{"BTN_SIDE", 0x113},
-{"BTN_EXTRA", 0x114},
-{"BTN_FORWARD", 0x115},
-{"BTN_BACK", 0x116},
-{"BTN_TASK", 0x117},
-{"BTN_JOYSTICK", 0x120},
-{"BTN_TRIGGER", 0x120},
-{"BTN_THUMB", 0x121},
-{"BTN_THUMB2", 0x122},
-{"BTN_TOP", 0x123},
-{"BTN_TOP2", 0x124},
-{"BTN_PINKIE", 0x125},
-{"BTN_BASE", 0x126},
-{"BTN_BASE2", 0x127},
-{"BTN_BASE3", 0x128},
-{"BTN_BASE4", 0x129},
-{"BTN_BASE5", 0x12a},
-{"BTN_BASE6", 0x12b},
-{"BTN_DEAD", 0x12f},
-{"BTN_GAMEPAD", 0x130},
-{"BTN_A", 0x130},
-{"BTN_B", 0x131},
-{"BTN_C", 0x132},
-{"BTN_X", 0x133},
-{"BTN_Y", 0x134},
-{"BTN_Z", 0x135},
-{"BTN_TL", 0x136},
-{"BTN_TR", 0x137},
-{"BTN_TL2", 0x138},
-{"BTN_TR2", 0x139},
-{"BTN_SELECT", 0x13a},
-{"BTN_START", 0x13b},
-{"BTN_MODE", 0x13c},
-{"BTN_THUMBL", 0x13d},
-{"BTN_THUMBR", 0x13e},
-{"BTN_DIGI", 0x140},
-{"BTN_TOOL_PEN", 0x140},
-{"BTN_TOOL_RUBBER", 0x141},
-{"BTN_TOOL_BRUSH", 0x142},
-{"BTN_TOOL_PENCIL", 0x143},
-{"BTN_TOOL_AIRBRUSH", 0x144},
-{"BTN_TOOL_FINGER", 0x145},
-{"BTN_TOOL_MOUSE", 0x146},
-{"BTN_TOOL_LENS", 0x147},
-{"BTN_TOUCH", 0x14a},
-{"BTN_STYLUS", 0x14b},
-{"BTN_STYLUS2", 0x14c},
-{"BTN_TOOL_DOUBLETAP", 0x14d},
-{"BTN_TOOL_TRIPLETAP", 0x14e},
-{"BTN_TOOL_QUADTAP", 0x14f},
-{"BTN_WHEEL", 0x150},
-{"BTN_GEAR_DOWN", 0x150},
-{"BTN_GEAR_UP", 0x151},
-{"BTN_TRIGGER_HAPPY", 0x2c0},
-{"BTN_TRIGGER_HAPPY1", 0x2c0},
-{"BTN_TRIGGER_HAPPY2", 0x2c1},
-{"BTN_TRIGGER_HAPPY3", 0x2c2},
-{"BTN_TRIGGER_HAPPY4", 0x2c3},
-{"BTN_TRIGGER_HAPPY5", 0x2c4},
-{"BTN_TRIGGER_HAPPY6", 0x2c5},
-{"BTN_TRIGGER_HAPPY7", 0x2c6},
-{"BTN_TRIGGER_HAPPY8", 0x2c7},
-{"BTN_TRIGGER_HAPPY9", 0x2c8},
-{"BTN_TRIGGER_HAPPY10", 0x2c9},
-{"BTN_TRIGGER_HAPPY11", 0x2ca},
-{"BTN_TRIGGER_HAPPY12", 0x2cb},
-{"BTN_TRIGGER_HAPPY13", 0x2cc},
-{"BTN_TRIGGER_HAPPY14", 0x2cd},
-{"BTN_TRIGGER_HAPPY15", 0x2ce},
-{"BTN_TRIGGER_HAPPY16", 0x2cf},
-{"BTN_TRIGGER_HAPPY17", 0x2d0},
-{"BTN_TRIGGER_HAPPY18", 0x2d1},
-{"BTN_TRIGGER_HAPPY19", 0x2d2},
-{"BTN_TRIGGER_HAPPY20", 0x2d3},
-{"BTN_TRIGGER_HAPPY21", 0x2d4},
-{"BTN_TRIGGER_HAPPY22", 0x2d5},
-{"BTN_TRIGGER_HAPPY23", 0x2d6},
-{"BTN_TRIGGER_HAPPY24", 0x2d7},
-{"BTN_TRIGGER_HAPPY25", 0x2d8},
-{"BTN_TRIGGER_HAPPY26", 0x2d9},
-{"BTN_TRIGGER_HAPPY27", 0x2da},
-{"BTN_TRIGGER_HAPPY28", 0x2db},
-{"BTN_TRIGGER_HAPPY29", 0x2dc},
-{"BTN_TRIGGER_HAPPY30", 0x2dd},
-{"BTN_TRIGGER_HAPPY31", 0x2de},
-{"BTN_TRIGGER_HAPPY32", 0x2df},
-{"BTN_TRIGGER_HAPPY33", 0x2e0},
-{"BTN_TRIGGER_HAPPY34", 0x2e1},
-{"BTN_TRIGGER_HAPPY35", 0x2e2},
-{"BTN_TRIGGER_HAPPY36", 0x2e3},
-{"BTN_TRIGGER_HAPPY37", 0x2e4},
-{"BTN_TRIGGER_HAPPY38", 0x2e5},
-{"BTN_TRIGGER_HAPPY39", 0x2e6},
-{"BTN_TRIGGER_HAPPY40", 0x2e7},
-{"KEY_RESERVED", 0},
-{"KEY_ESC", 1},
-{"KEY_1", 2},
-{"KEY_2", 3},
-{"KEY_3", 4},
-{"KEY_4", 5},
-{"KEY_5", 6},
-{"KEY_6", 7},
-{"KEY_7", 8},
-{"KEY_8", 9},
-{"KEY_9", 10},
-{"KEY_0", 11},
-{"KEY_MINUS", 12},
-{"KEY_EQUAL", 13},
-{"KEY_BACKSPACE", 14},
-{"KEY_TAB", 15},
-{"KEY_Q", 16},
-{"KEY_W", 17},
-{"KEY_E", 18},
-{"KEY_R", 19},
-{"KEY_T", 20},
-{"KEY_Y", 21},
-{"KEY_U", 22},
-{"KEY_I", 23},
-{"KEY_O", 24},
-{"KEY_P", 25},
-{"KEY_LEFTBRACE", 26},
-{"KEY_RIGHTBRACE", 27},
-{"KEY_ENTER", 28},
-{"KEY_LEFTCTRL", 29},
-{"KEY_A", 30},
-{"KEY_S", 31},
-{"KEY_D", 32},
-{"KEY_F", 33},
-{"KEY_G", 34},
-{"KEY_H", 35},
-{"KEY_J", 36},
-{"KEY_K", 37},
-{"KEY_L", 38},
-{"KEY_SEMICOLON", 39},
-{"KEY_APOSTROPHE", 40},
-{"KEY_GRAVE", 41},
-{"KEY_LEFTSHIFT", 42},
-{"KEY_BACKSLASH", 43},
-{"KEY_Z", 44},
-{"KEY_X", 45},
-{"KEY_C", 46},
-{"KEY_V", 47},
-{"KEY_B", 48},
-{"KEY_N", 49},
-{"KEY_M", 50},
-{"KEY_COMMA", 51},
-{"KEY_DOT", 52},
-{"KEY_SLASH", 53},
-{"KEY_RIGHTSHIFT", 54},
-{"KEY_KPASTERISK", 55},
-{"KEY_LEFTALT", 56},
-{"KEY_SPACE", 57},
-{"KEY_CAPSLOCK", 58},
-{"KEY_F1", 59},
-{"KEY_F2", 60},
-{"KEY_F3", 61},
-{"KEY_F4", 62},
-{"KEY_F5", 63},
-{"KEY_F6", 64},
-{"KEY_F7", 65},
-{"KEY_F8", 66},
-{"KEY_F9", 67},
-{"KEY_F10", 68},
-{"KEY_NUMLOCK", 69},
-{"KEY_SCROLLLOCK", 70},
-{"KEY_KP7", 71},
-{"KEY_KP8", 72},
-{"KEY_KP9", 73},
-{"KEY_KPMINUS", 74},
-{"KEY_KP4", 75},
-{"KEY_KP5", 76},
-{"KEY_KP6", 77},
-{"KEY_KPPLUS", 78},
-{"KEY_KP1", 79},
-{"KEY_KP2", 80},
-{"KEY_KP3", 81},
-{"KEY_KP0", 82},
-{"KEY_KPDOT", 83},
-{"KEY_ZENKAKUHANKAKU", 85},
-{"KEY_102ND", 86},
-{"KEY_F11", 87},
-{"KEY_F12", 88},
-{"KEY_RO", 89},
-{"KEY_KATAKANA", 90},
-{"KEY_HIRAGANA", 91},
-{"KEY_HENKAN", 92},
-{"KEY_KATAKANAHIRAGANA", 93},
-{"KEY_MUHENKAN", 94},
-{"KEY_KPJPCOMMA", 95},
-{"KEY_KPENTER", 96},
-{"KEY_RIGHTCTRL", 97},
-{"KEY_KPSLASH", 98},
-{"KEY_SYSRQ", 99},
-{"KEY_RIGHTALT", 100},
-{"KEY_LINEFEED", 101},
-{"KEY_HOME", 102},
-{"KEY_UP", 103},
-{"KEY_PAGEUP", 104},
-{"KEY_LEFT", 105},
-{"KEY_RIGHT", 106},
-{"KEY_END", 107},
-{"KEY_DOWN", 108},
-{"KEY_PAGEDOWN", 109},
-{"KEY_INSERT", 110},
-{"KEY_DELETE", 111},
-{"KEY_MACRO", 112},
-{"KEY_MUTE", 113},
-{"KEY_VOLUMEDOWN", 114},
-{"KEY_VOLUMEUP", 115},
-{"KEY_POWER", 116},
-{"KEY_KPEQUAL", 117},
-{"KEY_KPPLUSMINUS", 118},
-{"KEY_PAUSE", 119},
-{"KEY_SCALE", 120},
-{"KEY_KPCOMMA", 121},
-{"KEY_HANGEUL", 122},
-{"KEY_HANGUEL", KEY_HANGEUL},
-{"KEY_HANJA", 123},
-{"KEY_YEN", 124},
-{"KEY_LEFTMETA", 125},
-{"KEY_RIGHTMETA", 126},
-{"KEY_COMPOSE", 127},
-{"KEY_STOP", 128},
-{"KEY_AGAIN", 129},
-{"KEY_PROPS", 130},
-{"KEY_UNDO", 131},
-{"KEY_FRONT", 132},
-{"KEY_COPY", 133},
-{"KEY_OPEN", 134},
-{"KEY_PASTE", 135},
-{"KEY_FIND", 136},
-{"KEY_CUT", 137},
-{"KEY_HELP", 138},
-{"KEY_MENU", 139},
-{"KEY_CALC", 140},
-{"KEY_SETUP", 141},
-{"KEY_SLEEP", 142},
-{"KEY_WAKEUP", 143},
-{"KEY_FILE", 144},
-{"KEY_SENDFILE", 145},
-{"KEY_DELETEFILE", 146},
-{"KEY_XFER", 147},
-{"KEY_PROG1", 148},
-{"KEY_PROG2", 149},
-{"KEY_WWW", 150},
-{"KEY_MSDOS", 151},
-{"KEY_COFFEE", 152},
-{"KEY_SCREENLOCK", KEY_COFFEE},
-{"KEY_DIRECTION", 153},
-{"KEY_CYCLEWINDOWS", 154},
-{"KEY_MAIL", 155},
-{"KEY_BOOKMARKS", 156},
-{"KEY_COMPUTER", 157},
-{"KEY_BACK", 158},
-{"KEY_FORWARD", 159},
-{"KEY_CLOSECD", 160},
-{"KEY_EJECTCD", 161},
-{"KEY_EJECTCLOSECD", 162},
-{"KEY_NEXTSONG", 163},
-{"KEY_PLAYPAUSE", 164},
-{"KEY_PREVIOUSSONG", 165},
-{"KEY_STOPCD", 166},
-{"KEY_RECORD", 167},
-{"KEY_REWIND", 168},
-{"KEY_PHONE", 169},
-{"KEY_ISO", 170},
-{"KEY_CONFIG", 171},
-{"KEY_HOMEPAGE", 172},
-{"KEY_REFRESH", 173},
-{"KEY_EXIT", 174},
-{"KEY_MOVE", 175},
-{"KEY_EDIT", 176},
-{"KEY_SCROLLUP", 177},
-{"KEY_SCROLLDOWN", 178},
-{"KEY_KPLEFTPAREN", 179},
-{"KEY_KPRIGHTPAREN", 180},
-{"KEY_NEW", 181},
-{"KEY_REDO", 182},
-{"KEY_F13", 183},
-{"KEY_F14", 184},
-{"KEY_F15", 185},
-{"KEY_F16", 186},
-{"KEY_F17", 187},
-{"KEY_F18", 188},
-{"KEY_F19", 189},
-{"KEY_F20", 190},
-{"KEY_F21", 191},
-{"KEY_F22", 192},
-{"KEY_F23", 193},
-{"KEY_F24", 194},
-{"KEY_PLAYCD", 200},
-{"KEY_PAUSECD", 201},
-{"KEY_PROG3", 202},
-{"KEY_PROG4", 203},
-{"KEY_DASHBOARD", 204},
-{"KEY_SUSPEND", 205},
-{"KEY_CLOSE", 206},
-{"KEY_PLAY", 207},
-{"KEY_FASTFORWARD", 208},
-{"KEY_BASSBOOST", 209},
-{"KEY_PRINT", 210},
-{"KEY_HP", 211},
-{"KEY_CAMERA", 212},
-{"KEY_SOUND", 213},
-{"KEY_QUESTION", 214},
-{"KEY_EMAIL", 215},
-{"KEY_CHAT", 216},
-{"KEY_SEARCH", 217},
-{"KEY_CONNECT", 218},
-{"KEY_FINANCE", 219},
-{"KEY_SPORT", 220},
-{"KEY_SHOP", 221},
-{"KEY_ALTERASE", 222},
-{"KEY_CANCEL", 223},
-{"KEY_BRIGHTNESSDOWN", 224},
-{"KEY_BRIGHTNESSUP", 225},
-{"KEY_MEDIA", 226},
-{"KEY_SWITCHVIDEOMODE", 227},
-{"KEY_KBDILLUMTOGGLE", 228},
-{"KEY_KBDILLUMDOWN", 229},
-{"KEY_KBDILLUMUP", 230},
-{"KEY_SEND", 231},
-{"KEY_REPLY", 232},
-{"KEY_FORWARDMAIL", 233},
-{"KEY_SAVE", 234},
-{"KEY_DOCUMENTS", 235},
-{"KEY_BATTERY", 236},
-{"KEY_BLUETOOTH", 237},
-{"KEY_WLAN", 238},
-{"KEY_UWB", 239},
-{"KEY_UNKNOWN", 240},
-{"KEY_VIDEO_NEXT", 241},
-{"KEY_VIDEO_PREV", 242},
-{"KEY_BRIGHTNESS_CYCLE", 243},
-{"KEY_BRIGHTNESS_ZERO", 244},
-{"KEY_DISPLAY_OFF", 245},
-{"KEY_WIMAX", 246},
-{"KEY_RFKILL", 247},
-{"KEY_MICMUTE", 248},
-{"KEY_OK", 0x160},
-{"KEY_SELECT", 0x161},
-{"KEY_GOTO", 0x162},
-{"KEY_CLEAR", 0x163},
-{"KEY_POWER2", 0x164},
-{"KEY_OPTION", 0x165},
-{"KEY_INFO", 0x166},
-{"KEY_TIME", 0x167},
-{"KEY_VENDOR", 0x168},
-{"KEY_ARCHIVE", 0x169},
-{"KEY_PROGRAM", 0x16a},
-{"KEY_CHANNEL", 0x16b},
-{"KEY_FAVORITES", 0x16c},
-{"KEY_EPG", 0x16d},
-{"KEY_PVR", 0x16e},
-{"KEY_MHP", 0x16f},
-{"KEY_LANGUAGE", 0x170},
-{"KEY_TITLE", 0x171},
-{"KEY_SUBTITLE", 0x172},
-{"KEY_ANGLE", 0x173},
-{"KEY_ZOOM", 0x174},
-{"KEY_MODE", 0x175},
-{"KEY_KEYBOARD", 0x176},
-{"KEY_SCREEN", 0x177},
-{"KEY_PC", 0x178},
-{"KEY_TV", 0x179},
-{"KEY_TV2", 0x17a},
-{"KEY_VCR", 0x17b},
-{"KEY_VCR2", 0x17c},
-{"KEY_SAT", 0x17d},
-{"KEY_SAT2", 0x17e},
-{"KEY_CD", 0x17f},
-{"KEY_TAPE", 0x180},
-{"KEY_RADIO", 0x181},
-{"KEY_TUNER", 0x182},
-{"KEY_PLAYER", 0x183},
-{"KEY_TEXT", 0x184},
-{"KEY_DVD", 0x185},
-{"KEY_AUX", 0x186},
-{"KEY_MP3", 0x187},
-{"KEY_AUDIO", 0x188},
-{"KEY_VIDEO", 0x189},
-{"KEY_DIRECTORY", 0x18a},
-{"KEY_LIST", 0x18b},
-{"KEY_MEMO", 0x18c},
-{"KEY_CALENDAR", 0x18d},
-{"KEY_RED", 0x18e},
-{"KEY_GREEN", 0x18f},
-{"KEY_YELLOW", 0x190},
-{"KEY_BLUE", 0x191},
-{"KEY_CHANNELUP", 0x192},
-{"KEY_CHANNELDOWN", 0x193},
-{"KEY_FIRST", 0x194},
-{"KEY_LAST", 0x195},
-{"KEY_AB", 0x196},
-{"KEY_NEXT", 0x197},
-{"KEY_RESTART", 0x198},
-{"KEY_SLOW", 0x199},
-{"KEY_SHUFFLE", 0x19a},
-{"KEY_BREAK", 0x19b},
-{"KEY_PREVIOUS", 0x19c},
-{"KEY_DIGITS", 0x19d},
-{"KEY_TEEN", 0x19e},
-{"KEY_TWEN", 0x19f},
-{"KEY_VIDEOPHONE", 0x1a0},
-{"KEY_GAMES", 0x1a1},
-{"KEY_ZOOMIN", 0x1a2},
-{"KEY_ZOOMOUT", 0x1a3},
-{"KEY_ZOOMRESET", 0x1a4},
-{"KEY_WORDPROCESSOR", 0x1a5},
-{"KEY_EDITOR", 0x1a6},
-{"KEY_SPREADSHEET", 0x1a7},
-{"KEY_GRAPHICSEDITOR", 0x1a8},
-{"KEY_PRESENTATION", 0x1a9},
-{"KEY_DATABASE", 0x1aa},
-{"KEY_NEWS", 0x1ab},
-{"KEY_VOICEMAIL", 0x1ac},
-{"KEY_ADDRESSBOOK", 0x1ad},
-{"KEY_MESSENGER", 0x1ae},
-{"KEY_DISPLAYTOGGLE", 0x1af},
-{"KEY_SPELLCHECK", 0x1b0},
-{"KEY_LOGOFF", 0x1b1},
-{"KEY_DOLLAR", 0x1b2},
-{"KEY_EURO", 0x1b3},
-{"KEY_FRAMEBACK", 0x1b4},
-{"KEY_FRAMEFORWARD", 0x1b5},
-{"KEY_CONTEXT_MENU", 0x1b6},
-{"KEY_MEDIA_REPEAT", 0x1b7},
-{"KEY_10CHANNELSUP", 0x1b8},
-{"KEY_10CHANNELSDOWN", 0x1b9},
-{"KEY_IMAGES", 0x1ba},
-{"KEY_DEL_EOL", 0x1c0},
-{"KEY_DEL_EOS", 0x1c1},
-{"KEY_INS_LINE", 0x1c2},
-{"KEY_DEL_LINE", 0x1c3},
-{"KEY_FN", 0x1d0},
-{"KEY_FN_ESC", 0x1d1},
-{"KEY_FN_F1", 0x1d2},
-{"KEY_FN_F2", 0x1d3},
-{"KEY_FN_F3", 0x1d4},
-{"KEY_FN_F4", 0x1d5},
-{"KEY_FN_F5", 0x1d6},
-{"KEY_FN_F6", 0x1d7},
-{"KEY_FN_F7", 0x1d8},
-{"KEY_FN_F8", 0x1d9},
-{"KEY_FN_F9", 0x1da},
-{"KEY_FN_F10", 0x1db},
-{"KEY_FN_F11", 0x1dc},
-{"KEY_FN_F12", 0x1dd},
-{"KEY_FN_1", 0x1de},
-{"KEY_FN_2", 0x1df},
-{"KEY_FN_D", 0x1e0},
-{"KEY_FN_E", 0x1e1},
-{"KEY_FN_F", 0x1e2},
-{"KEY_FN_S", 0x1e3},
-{"KEY_FN_B", 0x1e4},
-{"KEY_BRL_DOT1", 0x1f1},
-{"KEY_BRL_DOT2", 0x1f2},
-{"KEY_BRL_DOT3", 0x1f3},
-{"KEY_BRL_DOT4", 0x1f4},
-{"KEY_BRL_DOT5", 0x1f5},
-{"KEY_BRL_DOT6", 0x1f6},
-{"KEY_BRL_DOT7", 0x1f7},
-{"KEY_BRL_DOT8", 0x1f8},
-{"KEY_BRL_DOT9", 0x1f9},
-{"KEY_BRL_DOT10", 0x1fa},
-{"KEY_NUMERIC_0", 0x200},
-{"KEY_NUMERIC_1", 0x201},
-{"KEY_NUMERIC_2", 0x202},
-{"KEY_NUMERIC_3", 0x203},
-{"KEY_NUMERIC_4", 0x204},
-{"KEY_NUMERIC_5", 0x205},
-{"KEY_NUMERIC_6", 0x206},
-{"KEY_NUMERIC_7", 0x207},
-{"KEY_NUMERIC_8", 0x208},
-{"KEY_NUMERIC_9", 0x209},
-{"KEY_NUMERIC_STAR", 0x20a},
-{"KEY_NUMERIC_POUND", 0x20b},
-{"KEY_CAMERA_FOCUS", 0x210},
-{"KEY_WPS_BUTTON", 0x211},
-{"KEY_TOUCHPAD_TOGGLE", 0x212},
-{"KEY_TOUCHPAD_ON", 0x213},
-{"KEY_TOUCHPAD_OFF", 0x214},
-{"KEY_CAMERA_ZOOMIN", 0x215},
-{"KEY_CAMERA_ZOOMOUT", 0x216},
-{"KEY_CAMERA_UP", 0x217},
-{"KEY_CAMERA_DOWN", 0x218},
-{"KEY_CAMERA_LEFT", 0x219},
-{"KEY_CAMERA_RIGHT", 0x21a},
-{"KEY_MIN_INTERESTING", KEY_MUTE},
-{"KEY_MAX", 0x2ff},
-{"KEY_CNT", (KEY_MAX+1)},
-{"SW_LID", 0x00},
-{"SW_TABLET_MODE", 0x01},
-{"SW_HEADPHONE_INSERT", 0x02},
-{"SW_RFKILL_ALL", 0x03},
-{"SW_RADIO", SW_RFKILL_ALL},
-{"SW_MICROPHONE_INSERT", 0x04},
-{"SW_DOCK", 0x05},
-{"SW_LINEOUT_INSERT", 0x06},
-{"SW_JACK_PHYSICAL_INSERT", 0x07},
-{"SW_VIDEOOUT_INSERT", 0x08},
-{"SW_CAMERA_LENS_COVER", 0x09},
-{"SW_KEYPAD_SLIDE", 0x0a},
-{"SW_FRONT_PROXIMITY", 0x0b},
-{"SW_ROTATE_LOCK", 0x0c},
-{"SW_MAX", 0x0f},
-{"SW_CNT", (SW_MAX+1)},
+/* All names back to back, tables below hold offsets into it instead of
+ * pointers, so they are half the size and need no relocations. It is
+ * longer than C99 requires compilers to support, hence __extension__
+ */
+const char linux_input_names[] = __extension__ "\0"
+	"BTN_0\0"
+	"BTN_1\0"
+	"BTN_2\0"
+	"BTN_3\0"
+	"BTN_4\0"
+	"BTN_5\0"
+	"BTN_6\0"
+	"BTN_7\0"
+	"BTN_8\0"
+	"BTN_9\0"
+	"BTN_A\0"
+	"BTN_B\0"
+	"BTN_BACK\0"
+	"BTN_BASE\0"
+	"BTN_BASE2\0"
+	"BTN_BASE3\0"
+	"BTN_BASE4\0"
+	"BTN_BASE5\0"
+	"BTN_BASE6\0"
+	"BTN_C\0"
+	"BTN_DEAD\0"
+	"BTN_DIGI\0"
+	"BTN_DPAD_DOWN\0"
+	"BTN_DPAD_LEFT\0"
+	"BTN_DPAD_RIGHT\0"
+	"BTN_DPAD_UP\0"
+	"BTN_EAST\0"
+	"BTN_EXTRA\0"
+	"BTN_FORWARD\0"
+	"BTN_GAMEPAD\0"
+	"BTN_GEAR_DOWN\0"
+	"BTN_GEAR_UP\0"
+	"BTN_JOYSTICK\0"
+	"BTN_LEFT\0"
+	"BTN_MIDDLE\0"
+	"BTN_MISC\0"
+	"BTN_MODE\0"
+	"BTN_MOUSE\0"
+	"BTN_NORTH\0"
+	"BTN_PINKIE\0"
+	"BTN_RIGHT\0"
+	"BTN_SELECT\0"
+	"BTN_SIDE\0"
+	"BTN_SOUTH\0"
+	"BTN_START\0"
+	"BTN_STYLUS\0"
+	"BTN_STYLUS2\0"
+	"BTN_STYLUS3\0"
+	"BTN_TASK\0"
+	"BTN_THUMB\0"
+	"BTN_THUMB2\0"
+	"BTN_THUMBL\0"
+	"BTN_THUMBR\0"
+	"BTN_TL\0"
+	"BTN_TL2\0"
+	"BTN_TOOL_AIRBRUSH\0"
+	"BTN_TOOL_BRUSH\0"
+	"BTN_TOOL_DOUBLETAP\0"
+	"BTN_TOOL_FINGER\0"
+	"BTN_TOOL_LENS\0"
+	"BTN_TOOL_MOUSE\0"
+	"BTN_TOOL_PEN\0"
+	"BTN_TOOL_PENCIL\0"
+	"BTN_TOOL_QUADTAP\0"
+	"BTN_TOOL_QUINTTAP\0"
+	"BTN_TOOL_RUBBER\0"
+	"BTN_TOOL_TRIPLETAP\0"
+	"BTN_TOP\0"
+	"BTN_TOP2\0"
+	"BTN_TOUCH\0"
+	"BTN_TR\0"
+	"BTN_TR2\0"
+	"BTN_TRIGGER\0"
+	"BTN_TRIGGER_HAPPY\0"
+	"BTN_TRIGGER_HAPPY1\0"
+	"BTN_TRIGGER_HAPPY10\0"
+	"BTN_TRIGGER_HAPPY11\0"
+	"BTN_TRIGGER_HAPPY12\0"
+	"BTN_TRIGGER_HAPPY13\0"
+	"BTN_TRIGGER_HAPPY14\0"
+	"BTN_TRIGGER_HAPPY15\0"
+	"BTN_TRIGGER_HAPPY16\0"
+	"BTN_TRIGGER_HAPPY17\0"
+	"BTN_TRIGGER_HAPPY18\0"
+	"BTN_TRIGGER_HAPPY19\0"
+	"BTN_TRIGGER_HAPPY2\0"
+	"BTN_TRIGGER_HAPPY20\0"
+	"BTN_TRIGGER_HAPPY21\0"
+	"BTN_TRIGGER_HAPPY22\0"
+	"BTN_TRIGGER_HAPPY23\0"
+	"BTN_TRIGGER_HAPPY24\0"
+	"BTN_TRIGGER_HAPPY25\0"
+	"BTN_TRIGGER_HAPPY26\0"
+	"BTN_TRIGGER_HAPPY27\0"
+	"BTN_TRIGGER_HAPPY28\0"
+	"BTN_TRIGGER_HAPPY29\0"
+	"BTN_TRIGGER_HAPPY3\0"
+	"BTN_TRIGGER_HAPPY30\0"
+	"BTN_TRIGGER_HAPPY31\0"
+	"BTN_TRIGGER_HAPPY32\0"
+	"BTN_TRIGGER_HAPPY33\0"
+	"BTN_TRIGGER_HAPPY34\0"
+	"BTN_TRIGGER_HAPPY35\0"
+	"BTN_TRIGGER_HAPPY36\0"
+	"BTN_TRIGGER_HAPPY37\0"
+	"BTN_TRIGGER_HAPPY38\0"
+	"BTN_TRIGGER_HAPPY39\0"
+	"BTN_TRIGGER_HAPPY4\0"
+	"BTN_TRIGGER_HAPPY40\0"
+	"BTN_TRIGGER_HAPPY5\0"
+	"BTN_TRIGGER_HAPPY6\0"
+	"BTN_TRIGGER_HAPPY7\0"
+	"BTN_TRIGGER_HAPPY8\0"
+	"BTN_TRIGGER_HAPPY9\0"
+	"BTN_WEST\0"
+	"BTN_WHEEL\0"
+	"BTN_X\0"
+	"BTN_Y\0"
+	"BTN_Z\0"
+	"KEY_0\0"
+	"KEY_1\0"
+	"KEY_102ND\0"
+	"KEY_10CHANNELSDOWN\0"
+	"KEY_10CHANNELSUP\0"
+	"KEY_2\0"
+	"KEY_3\0"
+	"KEY_3D_MODE\0"
+	"KEY_4\0"
+	"KEY_5\0"
+	"KEY_6\0"
+	"KEY_7\0"
+	"KEY_8\0"
+	"KEY_9\0"
+	"KEY_A\0"
+	"KEY_AB\0"
+	"KEY_ADDRESSBOOK\0"
+	"KEY_AGAIN\0"
+	"KEY_ALL_APPLICATIONS\0"
+	"KEY_ALS_TOGGLE\0"
+	"KEY_ALTERASE\0"
+	"KEY_ANGLE\0"
+	"KEY_APOSTROPHE\0"
+	"KEY_APPSELECT\0"
+	"KEY_ARCHIVE\0"
+	"KEY_ASPECT_RATIO\0"
+	"KEY_ASSISTANT\0"
+	"KEY_ATTENDANT_OFF\0"
+	"KEY_ATTENDANT_ON\0"
+	"KEY_ATTENDANT_TOGGLE\0"
+	"KEY_AUDIO\0"
+	"KEY_AUDIO_DESC\0"
+	"KEY_AUTOPILOT_ENGAGE_TOGGLE\0"
+	"KEY_AUX\0"
+	"KEY_B\0"
+	"KEY_BACK\0"
+	"KEY_BACKSLASH\0"
+	"KEY_BACKSPACE\0"
+	"KEY_BASSBOOST\0"
+	"KEY_BATTERY\0"
+	"KEY_BLUE\0"
+	"KEY_BLUETOOTH\0"
+	"KEY_BOOKMARKS\0"
+	"KEY_BREAK\0"
+	"KEY_BRIGHTNESSDOWN\0"
+	"KEY_BRIGHTNESSUP\0"
+	"KEY_BRIGHTNESS_AUTO\0"
+	"KEY_BRIGHTNESS_CYCLE\0"
+	"KEY_BRIGHTNESS_MAX\0"
+	"KEY_BRIGHTNESS_MENU\0"
+	"KEY_BRIGHTNESS_MIN\0"
+	"KEY_BRIGHTNESS_TOGGLE\0"
+	"KEY_BRIGHTNESS_ZERO\0"
+	"KEY_BRL_DOT1\0"
+	"KEY_BRL_DOT10\0"
+	"KEY_BRL_DOT2\0"
+	"KEY_BRL_DOT3\0"
+	"KEY_BRL_DOT4\0"
+	"KEY_BRL_DOT5\0"
+	"KEY_BRL_DOT6\0"
+	"KEY_BRL_DOT7\0"
+	"KEY_BRL_DOT8\0"
+	"KEY_BRL_DOT9\0"
+	"KEY_BUTTONCONFIG\0"
+	"KEY_C\0"
+	"KEY_CALC\0"
+	"KEY_CALENDAR\0"
+	"KEY_CAMERA\0"
+	"KEY_CAMERA_DOWN\0"
+	"KEY_CAMERA_FOCUS\0"
+	"KEY_CAMERA_LEFT\0"
+	"KEY_CAMERA_RIGHT\0"
+	"KEY_CAMERA_UP\0"
+	"KEY_CAMERA_ZOOMIN\0"
+	"KEY_CAMERA_ZOOMOUT\0"
+	"KEY_CANCEL\0"
+	"KEY_CAPSLOCK\0"
+	"KEY_CD\0"
+	"KEY_CHANNEL\0"
+	"KEY_CHANNELDOWN\0"
+	"KEY_CHANNELUP\0"
+	"KEY_CHAT\0"
+	"KEY_CLEAR\0"
+	"KEY_CLEARVU_SONAR\0"
+	"KEY_CLOSE\0"
+	"KEY_CLOSECD\0"
+	"KEY_CNT\0"
+	"KEY_COFFEE\0"
+	"KEY_COMMA\0"
+	"KEY_COMPOSE\0"
+	"KEY_COMPUTER\0"
+	"KEY_CONFIG\0"
+	"KEY_CONNECT\0"
+	"KEY_CONTEXT_MENU\0"
+	"KEY_CONTROLPANEL\0"
+	"KEY_COPY\0"
+	"KEY_CUT\0"
+	"KEY_CYCLEWINDOWS\0"
+	"KEY_D\0"
+	"KEY_DASHBOARD\0"
+	"KEY_DATA\0"
+	"KEY_DATABASE\0"
+	"KEY_DELETE\0"
+	"KEY_DELETEFILE\0"
+	"KEY_DEL_EOL\0"
+	"KEY_DEL_EOS\0"
+	"KEY_DEL_LINE\0"
+	"KEY_DICTATE\0"
+	"KEY_DIGITS\0"
+	"KEY_DIRECTION\0"
+	"KEY_DIRECTORY\0"
+	"KEY_DISPLAYTOGGLE\0"
+	"KEY_DISPLAY_OFF\0"
+	"KEY_DOCUMENTS\0"
+	"KEY_DOLLAR\0"
+	"KEY_DOT\0"
+	"KEY_DOWN\0"
+	"KEY_DUAL_RANGE_RADAR\0"
+	"KEY_DVD\0"
+	"KEY_E\0"
+	"KEY_EDIT\0"
+	"KEY_EDITOR\0"
+	"KEY_EJECTCD\0"
+	"KEY_EJECTCLOSECD\0"
+	"KEY_EMAIL\0"
+	"KEY_EMOJI_PICKER\0"
+	"KEY_END\0"
+	"KEY_ENTER\0"
+	"KEY_EPG\0"
+	"KEY_EQUAL\0"
+	"KEY_ESC\0"
+	"KEY_EURO\0"
+	"KEY_EXIT\0"
+	"KEY_F\0"
+	"KEY_F1\0"
+	"KEY_F10\0"
+	"KEY_F11\0"
+	"KEY_F12\0"
+	"KEY_F13\0"
+	"KEY_F14\0"
+	"KEY_F15\0"
+	"KEY_F16\0"
+	"KEY_F17\0"
+	"KEY_F18\0"
+	"KEY_F19\0"
+	"KEY_F2\0"
+	"KEY_F20\0"
+	"KEY_F21\0"
+	"KEY_F22\0"
+	"KEY_F23\0"
+	"KEY_F24\0"
+	"KEY_F3\0"
+	"KEY_F4\0"
+	"KEY_F5\0"
+	"KEY_F6\0"
+	"KEY_F7\0"
+	"KEY_F8\0"
+	"KEY_F9\0"
+	"KEY_FASTFORWARD\0"
+	"KEY_FASTREVERSE\0"
+	"KEY_FAVORITES\0"
+	"KEY_FILE\0"
+	"KEY_FINANCE\0"
+	"KEY_FIND\0"
+	"KEY_FIRST\0"
+	"KEY_FISHING_CHART\0"
+	"KEY_FN\0"
+	"KEY_FN_1\0"
+	"KEY_FN_2\0"
+	"KEY_FN_B\0"
+	"KEY_FN_D\0"
+	"KEY_FN_E\0"
+	"KEY_FN_ESC\0"
+	"KEY_FN_F\0"
+	"KEY_FN_F1\0"
+	"KEY_FN_F10\0"
+	"KEY_FN_F11\0"
+	"KEY_FN_F12\0"
+	"KEY_FN_F2\0"
+	"KEY_FN_F3\0"
+	"KEY_FN_F4\0"
+	"KEY_FN_F5\0"
+	"KEY_FN_F6\0"
+	"KEY_FN_F7\0"
+	"KEY_FN_F8\0"
+	"KEY_FN_F9\0"
+	"KEY_FN_RIGHT_SHIFT\0"
+	"KEY_FN_S\0"
+	"KEY_FORWARD\0"
+	"KEY_FORWARDMAIL\0"
+	"KEY_FRAMEBACK\0"
+	"KEY_FRAMEFORWARD\0"
+	"KEY_FRONT\0"
+	"KEY_FULL_SCREEN\0"
+	"KEY_G\0"
+	"KEY_GAMES\0"
+	"KEY_GOTO\0"
+	"KEY_GRAPHICSEDITOR\0"
+	"KEY_GRAVE\0"
+	"KEY_GREEN\0"
+	"KEY_H\0"
+	"KEY_HANGEUL\0"
+	"KEY_HANGUEL\0"
+	"KEY_HANGUP_PHONE\0"
+	"KEY_HANJA\0"
+	"KEY_HELP\0"
+	"KEY_HENKAN\0"
+	"KEY_HIRAGANA\0"
+	"KEY_HOME\0"
+	"KEY_HOMEPAGE\0"
+	"KEY_HP\0"
+	"KEY_I\0"
+	"KEY_IMAGES\0"
+	"KEY_INFO\0"
+	"KEY_INSERT\0"
+	"KEY_INS_LINE\0"
+	"KEY_ISO\0"
+	"KEY_J\0"
+	"KEY_JOURNAL\0"
+	"KEY_K\0"
+	"KEY_KATAKANA\0"
+	"KEY_KATAKANAHIRAGANA\0"
+	"KEY_KBDILLUMDOWN\0"
+	"KEY_KBDILLUMTOGGLE\0"
+	"KEY_KBDILLUMUP\0"
+	"KEY_KBDINPUTASSIST_ACCEPT\0"
+	"KEY_KBDINPUTASSIST_CANCEL\0"
+	"KEY_KBDINPUTASSIST_NEXT\0"
+	"KEY_KBDINPUTASSIST_NEXTGROUP\0"
+	"KEY_KBDINPUTASSIST_PREV\0"
+	"KEY_KBDINPUTASSIST_PREVGROUP\0"
+	"KEY_KBD_LAYOUT_NEXT\0"
+	"KEY_KBD_LCD_MENU1\0"
+	"KEY_KBD_LCD_MENU2\0"
+	"KEY_KBD_LCD_MENU3\0"
+	"KEY_KBD_LCD_MENU4\0"
+	"KEY_KBD_LCD_MENU5\0"
+	"KEY_KEYBOARD\0"
+	"KEY_KP0\0"
+	"KEY_KP1\0"
+	"KEY_KP2\0"
+	"KEY_KP3\0"
+	"KEY_KP4\0"
+	"KEY_KP5\0"
+	"KEY_KP6\0"
+	"KEY_KP7\0"
+	"KEY_KP8\0"
+	"KEY_KP9\0"
+	"KEY_KPASTERISK\0"
+	"KEY_KPCOMMA\0"
+	"KEY_KPDOT\0"
+	"KEY_KPENTER\0"
+	"KEY_KPEQUAL\0"
+	"KEY_KPJPCOMMA\0"
+	"KEY_KPLEFTPAREN\0"
+	"KEY_KPMINUS\0"
+	"KEY_KPPLUS\0"
+	"KEY_KPPLUSMINUS\0"
+	"KEY_KPRIGHTPAREN\0"
+	"KEY_KPSLASH\0"
+	"KEY_L\0"
+	"KEY_LANGUAGE\0"
+	"KEY_LAST\0"
+	"KEY_LEFT\0"
+	"KEY_LEFTALT\0"
+	"KEY_LEFTBRACE\0"
+	"KEY_LEFTCTRL\0"
+	"KEY_LEFTMETA\0"
+	"KEY_LEFTSHIFT\0"
+	"KEY_LEFT_DOWN\0"
+	"KEY_LEFT_UP\0"
+	"KEY_LIGHTS_TOGGLE\0"
+	"KEY_LINEFEED\0"
+	"KEY_LINK_PHONE\0"
+	"KEY_LIST\0"
+	"KEY_LOGOFF\0"
+	"KEY_M\0"
+	"KEY_MACRO\0"
+	"KEY_MACRO1\0"
+	"KEY_MACRO10\0"
+	"KEY_MACRO11\0"
+	"KEY_MACRO12\0"
+	"KEY_MACRO13\0"
+	"KEY_MACRO14\0"
+	"KEY_MACRO15\0"
+	"KEY_MACRO16\0"
+	"KEY_MACRO17\0"
+	"KEY_MACRO18\0"
+	"KEY_MACRO19\0"
+	"KEY_MACRO2\0"
+	"KEY_MACRO20\0"
+	"KEY_MACRO21\0"
+	"KEY_MACRO22\0"
+	"KEY_MACRO23\0"
+	"KEY_MACRO24\0"
+	"KEY_MACRO25\0"
+	"KEY_MACRO26\0"
+	"KEY_MACRO27\0"
+	"KEY_MACRO28\0"
+	"KEY_MACRO29\0"
+	"KEY_MACRO3\0"
+	"KEY_MACRO30\0"
+	"KEY_MACRO4\0"
+	"KEY_MACRO5\0"
+	"KEY_MACRO6\0"
+	"KEY_MACRO7\0"
+	"KEY_MACRO8\0"
+	"KEY_MACRO9\0"
+	"KEY_MACRO_PRESET1\0"
+	"KEY_MACRO_PRESET2\0"
+	"KEY_MACRO_PRESET3\0"
+	"KEY_MACRO_PRESET_CYCLE\0"
+	"KEY_MACRO_RECORD_START\0"
+	"KEY_MACRO_RECORD_STOP\0"
+	"KEY_MAIL\0"
+	"KEY_MARK_WAYPOINT\0"
+	"KEY_MAX\0"
+	"KEY_MEDIA\0"
+	"KEY_MEDIA_REPEAT\0"
+	"KEY_MEDIA_TOP_MENU\0"
+	"KEY_MEMO\0"
+	"KEY_MENU\0"
+	"KEY_MESSENGER\0"
+	"KEY_MHP\0"
+	"KEY_MICMUTE\0"
+	"KEY_MINUS\0"
+	"KEY_MIN_INTERESTING\0"
+	"KEY_MODE\0"
+	"KEY_MOVE\0"
+	"KEY_MP3\0"
+	"KEY_MSDOS\0"
+	"KEY_MUHENKAN\0"
+	"KEY_MUTE\0"
+	"KEY_N\0"
+	"KEY_NAV_CHART\0"
+	"KEY_NAV_INFO\0"
+	"KEY_NEW\0"
+	"KEY_NEWS\0"
+	"KEY_NEXT\0"
+	"KEY_NEXTSONG\0"
+	"KEY_NEXT_ELEMENT\0"
+	"KEY_NEXT_FAVORITE\0"
+	"KEY_NOTIFICATION_CENTER\0"
+	"KEY_NUMERIC_0\0"
+	"KEY_NUMERIC_1\0"
+	"KEY_NUMERIC_11\0"
+	"KEY_NUMERIC_12\0"
+	"KEY_NUMERIC_2\0"
+	"KEY_NUMERIC_3\0"
+	"KEY_NUMERIC_4\0"
+	"KEY_NUMERIC_5\0"
+	"KEY_NUMERIC_6\0"
+	"KEY_NUMERIC_7\0"
+	"KEY_NUMERIC_8\0"
+	"KEY_NUMERIC_9\0"
+	"KEY_NUMERIC_A\0"
+	"KEY_NUMERIC_B\0"
+	"KEY_NUMERIC_C\0"
+	"KEY_NUMERIC_D\0"
+	"KEY_NUMERIC_POUND\0"
+	"KEY_NUMERIC_STAR\0"
+	"KEY_NUMLOCK\0"
+	"KEY_O\0"
+	"KEY_OK\0"
+	"KEY_ONSCREEN_KEYBOARD\0"
+	"KEY_OPEN\0"
+	"KEY_OPTION\0"
+	"KEY_P\0"
+	"KEY_PAGEDOWN\0"
+	"KEY_PAGEUP\0"
+	"KEY_PASTE\0"
+	"KEY_PAUSE\0"
+	"KEY_PAUSECD\0"
+	"KEY_PAUSE_RECORD\0"
+	"KEY_PC\0"
+	"KEY_PHONE\0"
+	"KEY_PICKUP_PHONE\0"
+	"KEY_PLAY\0"
+	"KEY_PLAYCD\0"
+	"KEY_PLAYER\0"
+	"KEY_PLAYPAUSE\0"
+	"KEY_POWER\0"
+	"KEY_POWER2\0"
+	"KEY_PRESENTATION\0"
+	"KEY_PREVIOUS\0"
+	"KEY_PREVIOUSSONG\0"
+	"KEY_PREVIOUS_ELEMENT\0"
+	"KEY_PRINT\0"
+	"KEY_PRIVACY_SCREEN_TOGGLE\0"
+	"KEY_PROG1\0"
+	"KEY_PROG2\0"
+	"KEY_PROG3\0"
+	"KEY_PROG4\0"
+	"KEY_PROGRAM\0"
+	"KEY_PROPS\0"
+	"KEY_PVR\0"
+	"KEY_Q\0"
+	"KEY_QUESTION\0"
+	"KEY_R\0"
+	"KEY_RADAR_OVERLAY\0"
+	"KEY_RADIO\0"
+	"KEY_RECORD\0"
+	"KEY_RED\0"
+	"KEY_REDO\0"
+	"KEY_REFRESH\0"
+	"KEY_REFRESH_RATE_TOGGLE\0"
+	"KEY_REPLY\0"
+	"KEY_RESERVED\0"
+	"KEY_RESTART\0"
+	"KEY_REWIND\0"
+	"KEY_RFKILL\0"
+	"KEY_RIGHT\0"
+	"KEY_RIGHTALT\0"
+	"KEY_RIGHTBRACE\0"
+	"KEY_RIGHTCTRL\0"
+	"KEY_RIGHTMETA\0"
+	"KEY_RIGHTSHIFT\0"
+	"KEY_RIGHT_DOWN\0"
+	"KEY_RIGHT_UP\0"
+	"KEY_RO\0"
+	"KEY_ROOT_MENU\0"
+	"KEY_ROTATE_DISPLAY\0"
+	"KEY_ROTATE_LOCK_TOGGLE\0"
+	"KEY_S\0"
+	"KEY_SAT\0"
+	"KEY_SAT2\0"
+	"KEY_SAVE\0"
+	"KEY_SCALE\0"
+	"KEY_SCREEN\0"
+	"KEY_SCREENLOCK\0"
+	"KEY_SCREENSAVER\0"
+	"KEY_SCROLLDOWN\0"
+	"KEY_SCROLLLOCK\0"
+	"KEY_SCROLLUP\0"
+	"KEY_SEARCH\0"
+	"KEY_SELECT\0"
+	"KEY_SELECTIVE_SCREENSHOT\0"
+	"KEY_SEMICOLON\0"
+	"KEY_SEND\0"
+	"KEY_SENDFILE\0"
+	"KEY_SETUP\0"
+	"KEY_SHOP\0"
+	"KEY_SHUFFLE\0"
+	"KEY_SIDEVU_SONAR\0"
+	"KEY_SINGLE_RANGE_RADAR\0"
+	"KEY_SLASH\0"
+	"KEY_SLEEP\0"
+	"KEY_SLOW\0"
+	"KEY_SLOWREVERSE\0"
+	"KEY_SOS\0"
+	"KEY_SOUND\0"
+	"KEY_SPACE\0"
+	"KEY_SPELLCHECK\0"
+	"KEY_SPORT\0"
+	"KEY_SPREADSHEET\0"
+	"KEY_STOP\0"
+	"KEY_STOPCD\0"
+	"KEY_STOP_RECORD\0"
+	"KEY_SUBTITLE\0"
+	"KEY_SUSPEND\0"
+	"KEY_SWITCHVIDEOMODE\0"
+	"KEY_SYSRQ\0"
+	"KEY_T\0"
+	"KEY_TAB\0"
+	"KEY_TAPE\0"
+	"KEY_TASKMANAGER\0"
+	"KEY_TEEN\0"
+	"KEY_TEXT\0"
+	"KEY_TIME\0"
+	"KEY_TITLE\0"
+	"KEY_TOUCHPAD_OFF\0"
+	"KEY_TOUCHPAD_ON\0"
+	"KEY_TOUCHPAD_TOGGLE\0"
+	"KEY_TRADITIONAL_SONAR\0"
+	"KEY_TUNER\0"
+	"KEY_TV\0"
+	"KEY_TV2\0"
+	"KEY_TWEN\0"
+	"KEY_U\0"
+	"KEY_UNDO\0"
+	"KEY_UNKNOWN\0"
+	"KEY_UNMUTE\0"
+	"KEY_UP\0"
+	"KEY_UWB\0"
+	"KEY_V\0"
+	"KEY_VCR\0"
+	"KEY_VCR2\0"
+	"KEY_VENDOR\0"
+	"KEY_VIDEO\0"
+	"KEY_VIDEOPHONE\0"
+	"KEY_VIDEO_NEXT\0"
+	"KEY_VIDEO_PREV\0"
+	"KEY_VOD\0"
+	"KEY_VOICECOMMAND\0"
+	"KEY_VOICEMAIL\0"
+	"KEY_VOLUMEDOWN\0"
+	"KEY_VOLUMEUP\0"
+	"KEY_W\0"
+	"KEY_WAKEUP\0"
+	"KEY_WIMAX\0"
+	"KEY_WLAN\0"
+	"KEY_WORDPROCESSOR\0"
+	"KEY_WPS_BUTTON\0"
+	"KEY_WWAN\0"
+	"KEY_WWW\0"
+	"KEY_X\0"
+	"KEY_XFER\0"
+	"KEY_Y\0"
+	"KEY_YELLOW\0"
+	"KEY_YEN\0"
+	"KEY_Z\0"
+	"KEY_ZENKAKUHANKAKU\0"
+	"KEY_ZOOM\0"
+	"KEY_ZOOMIN\0"
+	"KEY_ZOOMOUT\0"
+	"KEY_ZOOMRESET\0"
+	"SW_CAMERA_LENS_COVER\0"
+	"SW_CNT\0"
+	"SW_DOCK\0"
+	"SW_FRONT_PROXIMITY\0"
+	"SW_HEADPHONE_INSERT\0"
+	"SW_JACK_PHYSICAL_INSERT\0"
+	"SW_KEYPAD_SLIDE\0"
+	"SW_LID\0"
+	"SW_LINEIN_INSERT\0"
+	"SW_LINEOUT_INSERT\0"
+	"SW_MACHINE_COVER\0"
+	"SW_MAX\0"
+	"SW_MICROPHONE_INSERT\0"
+	"SW_MUTE_DEVICE\0"
+	"SW_PEN_INSERTED\0"
+	"SW_RADIO\0"
+	"SW_RFKILL_ALL\0"
+	"SW_ROTATE_LOCK\0"
+	"SW_TABLET_MODE\0"
+	"SW_VIDEOOUT_INSERT\0";
+
+/* Sorted by name (in C locale) for binary search */
+const struct input_map_entry linux_input_map[] = {
+{1, 0x100, EVENT_KEY},
+{7, 0x101, EVENT_KEY},
+{13, 0x102, EVENT_KEY},
+{19, 0x103, EVENT_KEY},
+{25, 0x104, EVENT_KEY},
+{31, 0x105, EVENT_KEY},
+{37, 0x106, EVENT_KEY},
+{43, 0x107, EVENT_KEY},
+{49, 0x108, EVENT_KEY},
+{55, 0x109, EVENT_KEY},
+{61, BTN_SOUTH, EVENT_KEY},
+{67, BTN_EAST, EVENT_KEY},
+{73, 0x116, EVENT_KEY},
+{82, 0x126, EVENT_KEY},
+{91, 0x127, EVENT_KEY},
+{101, 0x128, EVENT_KEY},
+{111, 0x129, EVENT_KEY},
+{121, 0x12a, EVENT_KEY},
+{131, 0x12b, EVENT_KEY},
+{141, 0x132, EVENT_KEY},
+{147, 0x12f, EVENT_KEY},
+{156, 0x140, EVENT_KEY},
+{165, 0x221, EVENT_KEY},
+{179, 0x222, EVENT_KEY},
+{193, 0x223, EVENT_KEY},
+{208, 0x220, EVENT_KEY},
+{220, 0x131, EVENT_KEY},
+{229, 0x114, EVENT_KEY},
+{239, 0x115, EVENT_KEY},
+{251, 0x130, EVENT_KEY},
+{263, 0x150, EVENT_KEY},
+{277, 0x151, EVENT_KEY},
+{289, 0x120, EVENT_KEY},
+{302, 0x110, EVENT_KEY},
+{311, 0x112, EVENT_KEY},
+{322, 0x100, EVENT_KEY},
+{331, 0x13c, EVENT_KEY},
+{340, 0x110, EVENT_KEY},
+{350, 0x133, EVENT_KEY},
+{360, 0x125, EVENT_KEY},
+{371, 0x111, EVENT_KEY},
+{381, 0x13a, EVENT_KEY},
+{392, 0x113, EVENT_KEY},
+{401, 0x130, EVENT_KEY},
+{411, 0x13b, EVENT_KEY},
+{421, 0x14b, EVENT_KEY},
+{432, 0x14c, EVENT_KEY},
+{444, 0x149, EVENT_KEY},
+{456, 0x117, EVENT_KEY},
+{465, 0x121, EVENT_KEY},
+{475, 0x122, EVENT_KEY},
+{486, 0x13d, EVENT_KEY},
+{497, 0x13e, EVENT_KEY},
+{508, 0x136, EVENT_KEY},
+{515, 0x138, EVENT_KEY},
+{523, 0x144, EVENT_KEY},
+{541, 0x142, EVENT_KEY},
+{556, 0x14d, EVENT_KEY},
+{575, 0x145, EVENT_KEY},
+{591, 0x147, EVENT_KEY},
+{605, 0x146, EVENT_KEY},
+{620, 0x140, EVENT_KEY},
+{633, 0x143, EVENT_KEY},
+{649, 0x14f, EVENT_KEY},
+{666, 0x148, EVENT_KEY},
+{684, 0x141, EVENT_KEY},
+{700, 0x14e, EVENT_KEY},
+{719, 0x123, EVENT_KEY},
+{727, 0x124, EVENT_KEY},
+{736, 0x14a, EVENT_KEY},
+{746, 0x137, EVENT_KEY},
+{753, 0x139, EVENT_KEY},
+{761, 0x120, EVENT_KEY},
+{773, 0x2c0, EVENT_KEY},
+{791, 0x2c0, EVENT_KEY},
+{810, 0x2c9, EVENT_KEY},
+{830, 0x2ca, EVENT_KEY},
+{850, 0x2cb, EVENT_KEY},
+{870, 0x2cc, EVENT_KEY},
+{890, 0x2cd, EVENT_KEY},
+{910, 0x2ce, EVENT_KEY},
+{930, 0x2cf, EVENT_KEY},
+{950, 0x2d0, EVENT_KEY},
+{970, 0x2d1, EVENT_KEY},
+{990, 0x2d2, EVENT_KEY},
+{1010, 0x2c1, EVENT_KEY},
+{1029, 0x2d3, EVENT_KEY},
+{1049, 0x2d4, EVENT_KEY},
+{1069, 0x2d5, EVENT_KEY},
+{1089, 0x2d6, EVENT_KEY},
+{1109, 0x2d7, EVENT_KEY},
+{1129, 0x2d8, EVENT_KEY},
+{1149, 0x2d9, EVENT_KEY},
+{1169, 0x2da, EVENT_KEY},
+{1189, 0x2db, EVENT_KEY},
+{1209, 0x2dc, EVENT_KEY},
+{1229, 0x2c2, EVENT_KEY},
+{1248, 0x2dd, EVENT_KEY},
+{1268, 0x2de, EVENT_KEY},
+{1288, 0x2df, EVENT_KEY},
+{1308, 0x2e0, EVENT_KEY},
+{1328, 0x2e1, EVENT_KEY},
+{1348, 0x2e2, EVENT_KEY},
+{1368, 0x2e3, EVENT_KEY},
+{1388, 0x2e4, EVENT_KEY},
+{1408, 0x2e5, EVENT_KEY},
+{1428, 0x2e6, EVENT_KEY},
+{1448, 0x2c3, EVENT_KEY},
+{1467, 0x2e7, EVENT_KEY},
+{1487, 0x2c4, EVENT_KEY},
+{1506, 0x2c5, EVENT_KEY},
+{1525, 0x2c6, EVENT_KEY},
+{1544, 0x2c7, EVENT_KEY},
+{1563, 0x2c8, EVENT_KEY},
+{1582, 0x134, EVENT_KEY},
+{1591, 0x150, EVENT_KEY},
+{1601, BTN_NORTH, EVENT_KEY},
+{1607, BTN_WEST, EVENT_KEY},
+{1613, 0x135, EVENT_KEY},
+{1619, 11, EVENT_KEY},
+{1625, 2, EVENT_KEY},
+{1631, 86, EVENT_KEY},
+{1641, 0x1b9, EVENT_KEY},
+{1660, 0x1b8, EVENT_KEY},
+{1677, 3, EVENT_KEY},
+{1683, 4, EVENT_KEY},
+{1689, 0x26f, EVENT_KEY},
+{1701, 5, EVENT_KEY},
+{1707, 6, EVENT_KEY},
+{1713, 7, EVENT_KEY},
+{1719, 8, EVENT_KEY},
+{1725, 9, EVENT_KEY},
+{1731, 10, EVENT_KEY},
+{1737, 30, EVENT_KEY},
+{1743, 0x196, EVENT_KEY},
+{1750, 0x1ad, EVENT_KEY},
+{1766, 129, EVENT_KEY},
+{1776, 204, EVENT_KEY},
+{1797, 0x230, EVENT_KEY},
+{1812, 222, EVENT_KEY},
+{1825, 0x173, EVENT_KEY},
+{1835, 40, EVENT_KEY},
+{1850, 0x244, EVENT_KEY},
+{1864, 0x169, EVENT_KEY},
+{1876, 0x177, EVENT_KEY},
+{1893, 0x247, EVENT_KEY},
+{1907, 0x21c, EVENT_KEY},
+{1925, 0x21b, EVENT_KEY},
+{1942, 0x21d, EVENT_KEY},
+{1963, 0x188, EVENT_KEY},
+{1973, 0x26e, EVENT_KEY},
+{1988, 0x27d, EVENT_KEY},
+{2016, 0x186, EVENT_KEY},
+{2024, 48, EVENT_KEY},
+{2030, 158, EVENT_KEY},
+{2039, 43, EVENT_KEY},
+{2053, 14, EVENT_KEY},
+{2067, 209, EVENT_KEY},
+{2081, 236, EVENT_KEY},
+{2093, 0x191, EVENT_KEY},
+{2102, 237, EVENT_KEY},
+{2116, 156, EVENT_KEY},
+{2130, 0x19b, EVENT_KEY},
+{2140, 224, EVENT_KEY},
+{2159, 225, EVENT_KEY},
+{2176, 244, EVENT_KEY},
+{2196, 243, EVENT_KEY},
+{2217, 0x251, EVENT_KEY},
+{2236, 0x289, EVENT_KEY},
+{2256, 0x250, EVENT_KEY},
+{2275, KEY_DISPLAYTOGGLE, EVENT_KEY},
+{2297, KEY_BRIGHTNESS_AUTO, EVENT_KEY},
+{2317, 0x1f1, EVENT_KEY},
+{2330, 0x1fa, EVENT_KEY},
+{2344, 0x1f2, EVENT_KEY},
+{2357, 0x1f3, EVENT_KEY},
+{2370, 0x1f4, EVENT_KEY},
+{2383, 0x1f5, EVENT_KEY},
+{2396, 0x1f6, EVENT_KEY},
+{2409, 0x1f7, EVENT_KEY},
+{2422, 0x1f8, EVENT_KEY},
+{2435, 0x1f9, EVENT_KEY},
+{2448, 0x240, EVENT_KEY},
+{2465, 46, EVENT_KEY},
+{2471, 140, EVENT_KEY},
+{2480, 0x18d, EVENT_KEY},
+{2493, 212, EVENT_KEY},
+{2504, 0x218, EVENT_KEY},
+{2520, 0x210, EVENT_KEY},
+{2537, 0x219, EVENT_KEY},
+{2553, 0x21a, EVENT_KEY},
+{2570, 0x217, EVENT_KEY},
+{2584, 0x215, EVENT_KEY},
+{2602, 0x216, EVENT_KEY},
+{2621, 223, EVENT_KEY},
+{2632, 58, EVENT_KEY},
+{2645, 0x17f, EVENT_KEY},
+{2652, 0x16b, EVENT_KEY},
+{2664, 0x193, EVENT_KEY},
+{2680, 0x192, EVENT_KEY},
+{2694, 216, EVENT_KEY},
+{2703, 0x163, EVENT_KEY},
+{2713, 0x286, EVENT_KEY},
+{2731, 206, EVENT_KEY},
+{2741, 160, EVENT_KEY},
+{2753, (KEY_MAX+1), EVENT_KEY},
+{2761, 152, EVENT_KEY},
+{2772, 51, EVENT_KEY},
+{2782, 127, EVENT_KEY},
+{2794, 157, EVENT_KEY},
+{2807, 171, EVENT_KEY},
+{2818, 218, EVENT_KEY},
+{2830, 0x1b6, EVENT_KEY},
+{2847, 0x243, EVENT_KEY},
+{2864, 133, EVENT_KEY},
+{2873, 137, EVENT_KEY},
+{2881, 154, EVENT_KEY},
+{2898, 32, EVENT_KEY},
+{2904, KEY_ALL_APPLICATIONS, EVENT_KEY},
+{2918, 0x277, EVENT_KEY},
+{2927, 0x1aa, EVENT_KEY},
+{2940, 111, EVENT_KEY},
+{2951, 146, EVENT_KEY},
+{2966, 0x1c0, EVENT_KEY},
+{2978, 0x1c1, EVENT_KEY},
+{2990, 0x1c3, EVENT_KEY},
+{3003, 0x24a, EVENT_KEY},
+{3015, 0x19d, EVENT_KEY},
+{3026, KEY_ROTATE_DISPLAY, EVENT_KEY},
+{3040, 0x18a, EVENT_KEY},
+{3054, 0x1af, EVENT_KEY},
+{3072, 245, EVENT_KEY},
+{3088, 235, EVENT_KEY},
+{3102, 0x1b2, EVENT_KEY},
+{3113, 52, EVENT_KEY},
+{3121, 108, EVENT_KEY},
+{3130, 0x283, EVENT_KEY},
+{3151, 0x185, EVENT_KEY},
+{3159, 18, EVENT_KEY},
+{3165, 176, EVENT_KEY},
+{3174, 0x1a6, EVENT_KEY},
+{3185, 161, EVENT_KEY},
+{3197, 162, EVENT_KEY},
+{3214, 215, EVENT_KEY},
+{3224, 0x249, EVENT_KEY},
+{3241, 107, EVENT_KEY},
+{3249, 28, EVENT_KEY},
+{3259, 0x16d, EVENT_KEY},
+{3267, 13, EVENT_KEY},
+{3277, 1, EVENT_KEY},
+{3285, 0x1b3, EVENT_KEY},
+{3294, 174, EVENT_KEY},
+{3303, 33, EVENT_KEY},
+{3309, 59, EVENT_KEY},
+{3316, 68, EVENT_KEY},
+{3324, 87, EVENT_KEY},
+{3332, 88, EVENT_KEY},
+{3340, 183, EVENT_KEY},
+{3348, 184, EVENT_KEY},
+{3356, 185, EVENT_KEY},
+{3364, 186, EVENT_KEY},
+{3372, 187, EVENT_KEY},
+{3380, 188, EVENT_KEY},
+{3388, 189, EVENT_KEY},
+{3396, 60, EVENT_KEY},
+{3403, 190, EVENT_KEY},
+{3411, 191, EVENT_KEY},
+{3419, 192, EVENT_KEY},
+{3427, 193, EVENT_KEY},
+{3435, 194, EVENT_KEY},
+{3443, 61, EVENT_KEY},
+{3450, 62, EVENT_KEY},
+{3457, 63, EVENT_KEY},
+{3464, 64, EVENT_KEY},
+{3471, 65, EVENT_KEY},
+{3478, 66, EVENT_KEY},
+{3485, 67, EVENT_KEY},
+{3492, 208, EVENT_KEY},
+{3508, 0x275, EVENT_KEY},
+{3524, 0x16c, EVENT_KEY},
+{3538, 144, EVENT_KEY},
+{3547, 219, EVENT_KEY},
+{3559, 136, EVENT_KEY},
+{3568, 0x194, EVENT_KEY},
+{3578, 0x281, EVENT_KEY},
+{3596, 0x1d0, EVENT_KEY},
+{3603, 0x1de, EVENT_KEY},
+{3612, 0x1df, EVENT_KEY},
+{3621, 0x1e4, EVENT_KEY},
+{3630, 0x1e0, EVENT_KEY},
+{3639, 0x1e1, EVENT_KEY},
+{3648, 0x1d1, EVENT_KEY},
+{3659, 0x1e2, EVENT_KEY},
+{3668, 0x1d2, EVENT_KEY},
+{3678, 0x1db, EVENT_KEY},
+{3689, 0x1dc, EVENT_KEY},
+{3700, 0x1dd, EVENT_KEY},
+{3711, 0x1d3, EVENT_KEY},
+{3721, 0x1d4, EVENT_KEY},
+{3731, 0x1d5, EVENT_KEY},
+{3741, 0x1d6, EVENT_KEY},
+{3751, 0x1d7, EVENT_KEY},
+{3761, 0x1d8, EVENT_KEY},
+{3771, 0x1d9, EVENT_KEY},
+{3781, 0x1da, EVENT_KEY},
+{3791, 0x1e5, EVENT_KEY},
+{3810, 0x1e3, EVENT_KEY},
+{3819, 159, EVENT_KEY},
+{3831, 233, EVENT_KEY},
+{3847, 0x1b4, EVENT_KEY},
+{3861, 0x1b5, EVENT_KEY},
+{3878, 132, EVENT_KEY},
+{3888, 0x174, EVENT_KEY},
+{3904, 34, EVENT_KEY},
+{3910, 0x1a1, EVENT_KEY},
+{3920, 0x162, EVENT_KEY},
+{3929, 0x1a8, EVENT_KEY},
+{3948, 41, EVENT_KEY},
+{3958, 0x18f, EVENT_KEY},
+{3968, 35, EVENT_KEY},
+{3974, 122, EVENT_KEY},
+{3986, KEY_HANGEUL, EVENT_KEY},
+{3998, 0x1be, EVENT_KEY},
+{4015, 123, EVENT_KEY},
+{4025, 138, EVENT_KEY},
+{4034, 92, EVENT_KEY},
+{4045, 91, EVENT_KEY},
+{4058, 102, EVENT_KEY},
+{4067, 172, EVENT_KEY},
+{4080, 211, EVENT_KEY},
+{4087, 23, EVENT_KEY},
+{4093, 0x1ba, EVENT_KEY},
+{4104, 0x166, EVENT_KEY},
+{4113, 110, EVENT_KEY},
+{4124, 0x1c2, EVENT_KEY},
+{4137, 170, EVENT_KEY},
+{4145, 36, EVENT_KEY},
+{4151, 0x242, EVENT_KEY},
+{4163, 37, EVENT_KEY},
+{4169, 90, EVENT_KEY},
+{4182, 93, EVENT_KEY},
+{4203, 229, EVENT_KEY},
+{4220, 228, EVENT_KEY},
+{4239, 230, EVENT_KEY},
+{4254, 0x264, EVENT_KEY},
+{4280, 0x265, EVENT_KEY},
+{4306, 0x261, EVENT_KEY},
+{4330, 0x263, EVENT_KEY},
+{4359, 0x260, EVENT_KEY},
+{4383, 0x262, EVENT_KEY},
+{4412, 0x248, EVENT_KEY},
+{4432, 0x2b8, EVENT_KEY},
+{4450, 0x2b9, EVENT_KEY},
+{4468, 0x2ba, EVENT_KEY},
+{4486, 0x2bb, EVENT_KEY},
+{4504, 0x2bc, EVENT_KEY},
+{4522, 0x176, EVENT_KEY},
+{4535, 82, EVENT_KEY},
+{4543, 79, EVENT_KEY},
+{4551, 80, EVENT_KEY},
+{4559, 81, EVENT_KEY},
+{4567, 75, EVENT_KEY},
+{4575, 76, EVENT_KEY},
+{4583, 77, EVENT_KEY},
+{4591, 71, EVENT_KEY},
+{4599, 72, EVENT_KEY},
+{4607, 73, EVENT_KEY},
+{4615, 55, EVENT_KEY},
+{4630, 121, EVENT_KEY},
+{4642, 83, EVENT_KEY},
+{4652, 96, EVENT_KEY},
+{4664, 117, EVENT_KEY},
+{4676, 95, EVENT_KEY},
+{4690, 179, EVENT_KEY},
+{4706, 74, EVENT_KEY},
+{4718, 78, EVENT_KEY},
+{4729, 118, EVENT_KEY},
+{4745, 180, EVENT_KEY},
+{4762, 98, EVENT_KEY},
+{4774, 38, EVENT_KEY},
+{4780, 0x170, EVENT_KEY},
+{4793, 0x195, EVENT_KEY},
+{4802, 105, EVENT_KEY},
+{4811, 56, EVENT_KEY},
+{4823, 26, EVENT_KEY},
+{4837, 29, EVENT_KEY},
+{4850, 125, EVENT_KEY},
+{4863, 42, EVENT_KEY},
+{4877, 0x269, EVENT_KEY},
+{4891, 0x268, EVENT_KEY},
+{4903, 0x21e, EVENT_KEY},
+{4921, 101, EVENT_KEY},
+{4934, 0x1bf, EVENT_KEY},
+{4949, 0x18b, EVENT_KEY},
+{4958, 0x1b1, EVENT_KEY},
+{4969, 50, EVENT_KEY},
+{4975, 112, EVENT_KEY},
+{4985, 0x290, EVENT_KEY},
+{4996, 0x299, EVENT_KEY},
+{5008, 0x29a, EVENT_KEY},
+{5020, 0x29b, EVENT_KEY},
+{5032, 0x29c, EVENT_KEY},
+{5044, 0x29d, EVENT_KEY},
+{5056, 0x29e, EVENT_KEY},
+{5068, 0x29f, EVENT_KEY},
+{5080, 0x2a0, EVENT_KEY},
+{5092, 0x2a1, EVENT_KEY},
+{5104, 0x2a2, EVENT_KEY},
+{5116, 0x291, EVENT_KEY},
+{5127, 0x2a3, EVENT_KEY},
+{5139, 0x2a4, EVENT_KEY},
+{5151, 0x2a5, EVENT_KEY},
+{5163, 0x2a6, EVENT_KEY},
+{5175, 0x2a7, EVENT_KEY},
+{5187, 0x2a8, EVENT_KEY},
+{5199, 0x2a9, EVENT_KEY},
+{5211, 0x2aa, EVENT_KEY},
+{5223, 0x2ab, EVENT_KEY},
+{5235, 0x2ac, EVENT_KEY},
+{5247, 0x292, EVENT_KEY},
+{5258, 0x2ad, EVENT_KEY},
+{5270, 0x293, EVENT_KEY},
+{5281, 0x294, EVENT_KEY},
+{5292, 0x295, EVENT_KEY},
+{5303, 0x296, EVENT_KEY},
+{5314, 0x297, EVENT_KEY},
+{5325, 0x298, EVENT_KEY},
+{5336, 0x2b3, EVENT_KEY},
+{5354, 0x2b4, EVENT_KEY},
+{5372, 0x2b5, EVENT_KEY},
+{5390, 0x2b2, EVENT_KEY},
+{5413, 0x2b0, EVENT_KEY},
+{5436, 0x2b1, EVENT_KEY},
+{5458, 155, EVENT_KEY},
+{5467, 0x27e, EVENT_KEY},
+{5485, 0x2ff, EVENT_KEY},
+{5493, 226, EVENT_KEY},
+{5503, 0x1b7, EVENT_KEY},
+{5520, 0x26b, EVENT_KEY},
+{5539, 0x18c, EVENT_KEY},
+{5548, 139, EVENT_KEY},
+{5557, 0x1ae, EVENT_KEY},
+{5571, 0x16f, EVENT_KEY},
+{5579, 248, EVENT_KEY},
+{5591, 12, EVENT_KEY},
+{5601, KEY_MUTE, EVENT_KEY},
+{5621, 0x175, EVENT_KEY},
+{5630, 175, EVENT_KEY},
+{5639, 0x187, EVENT_KEY},
+{5647, 151, EVENT_KEY},
+{5657, 94, EVENT_KEY},
+{5670, 113, EVENT_KEY},
+{5679, 49, EVENT_KEY},
+{5685, 0x280, EVENT_KEY},
+{5699, 0x288, EVENT_KEY},
+{5712, 181, EVENT_KEY},
+{5720, 0x1ab, EVENT_KEY},
+{5729, 0x197, EVENT_KEY},
+{5738, 163, EVENT_KEY},
+{5751, 0x27b, EVENT_KEY},
+{5768, 0x270, EVENT_KEY},
+{5786, 0x1bc, EVENT_KEY},
+{5810, 0x200, EVENT_KEY},
+{5824, 0x201, EVENT_KEY},
+{5838, 0x26c, EVENT_KEY},
+{5853, 0x26d, EVENT_KEY},
+{5868, 0x202, EVENT_KEY},
+{5882, 0x203, EVENT_KEY},
+{5896, 0x204, EVENT_KEY},
+{5910, 0x205, EVENT_KEY},
+{5924, 0x206, EVENT_KEY},
+{5938, 0x207, EVENT_KEY},
+{5952, 0x208, EVENT_KEY},
+{5966, 0x209, EVENT_KEY},
+{5980, 0x20c, EVENT_KEY},
+{5994, 0x20d, EVENT_KEY},
+{6008, 0x20e, EVENT_KEY},
+{6022, 0x20f, EVENT_KEY},
+{6036, 0x20b, EVENT_KEY},
+{6054, 0x20a, EVENT_KEY},
+{6071, 69, EVENT_KEY},
+{6083, 24, EVENT_KEY},
+{6089, 0x160, EVENT_KEY},
+{6096, 0x278, EVENT_KEY},
+{6118, 134, EVENT_KEY},
+{6127, 0x165, EVENT_KEY},
+{6138, 25, EVENT_KEY},
+{6144, 109, EVENT_KEY},
+{6157, 104, EVENT_KEY},
+{6168, 135, EVENT_KEY},
+{6178, 119, EVENT_KEY},
+{6188, 201, EVENT_KEY},
+{6200, 0x272, EVENT_KEY},
+{6217, 0x178, EVENT_KEY},
+{6224, 169, EVENT_KEY},
+{6234, 0x1bd, EVENT_KEY},
+{6251, 207, EVENT_KEY},
+{6260, 200, EVENT_KEY},
+{6271, 0x183, EVENT_KEY},
+{6282, 164, EVENT_KEY},
+{6296, 116, EVENT_KEY},
+{6306, 0x164, EVENT_KEY},
+{6317, 0x1a9, EVENT_KEY},
+{6334, 0x19c, EVENT_KEY},
+{6347, 165, EVENT_KEY},
+{6364, 0x27c, EVENT_KEY},
+{6385, 210, EVENT_KEY},
+{6395, 0x279, EVENT_KEY},
+{6421, 148, EVENT_KEY},
+{6431, 149, EVENT_KEY},
+{6441, 202, EVENT_KEY},
+{6451, 203, EVENT_KEY},
+{6461, 0x16a, EVENT_KEY},
+{6473, 130, EVENT_KEY},
+{6483, 0x16e, EVENT_KEY},
+{6491, 16, EVENT_KEY},
+{6497, 214, EVENT_KEY},
+{6510, 19, EVENT_KEY},
+{6516, 0x284, EVENT_KEY},
+{6534, 0x181, EVENT_KEY},
+{6544, 167, EVENT_KEY},
+{6555, 0x18e, EVENT_KEY},
+{6563, 182, EVENT_KEY},
+{6572, 173, EVENT_KEY},
+{6584, 0x232, EVENT_KEY},
+{6608, 232, EVENT_KEY},
+{6618, 0, EVENT_KEY},
+{6631, 0x198, EVENT_KEY},
+{6643, 168, EVENT_KEY},
+{6654, 247, EVENT_KEY},
+{6665, 106, EVENT_KEY},
+{6675, 100, EVENT_KEY},
+{6688, 27, EVENT_KEY},
+{6703, 97, EVENT_KEY},
+{6717, 126, EVENT_KEY},
+{6731, 54, EVENT_KEY},
+{6746, 0x267, EVENT_KEY},
+{6761, 0x266, EVENT_KEY},
+{6774, 89, EVENT_KEY},
+{6781, 0x26a, EVENT_KEY},
+{6795, 153, EVENT_KEY},
+{6814, 0x231, EVENT_KEY},
+{6837, 31, EVENT_KEY},
+{6843, 0x17d, EVENT_KEY},
+{6851, 0x17e, EVENT_KEY},
+{6860, 234, EVENT_KEY},
+{6869, 120, EVENT_KEY},
+{6879, KEY_ASPECT_RATIO, EVENT_KEY},
+{6890, KEY_COFFEE, EVENT_KEY},
+{6905, 0x245, EVENT_KEY},
+{6921, 178, EVENT_KEY},
+{6936, 70, EVENT_KEY},
+{6951, 177, EVENT_KEY},
+{6964, 217, EVENT_KEY},
+{6975, 0x161, EVENT_KEY},
+{6986, 0x27a, EVENT_KEY},
+{7011, 39, EVENT_KEY},
+{7025, 231, EVENT_KEY},
+{7034, 145, EVENT_KEY},
+{7047, 141, EVENT_KEY},
+{7057, 221, EVENT_KEY},
+{7066, 0x19a, EVENT_KEY},
+{7078, 0x287, EVENT_KEY},
+{7095, 0x282, EVENT_KEY},
+{7118, 53, EVENT_KEY},
+{7128, 142, EVENT_KEY},
+{7138, 0x199, EVENT_KEY},
+{7147, 0x276, EVENT_KEY},
+{7163, 0x27f, EVENT_KEY},
+{7171, 213, EVENT_KEY},
+{7181, 57, EVENT_KEY},
+{7191, 0x1b0, EVENT_KEY},
+{7206, 220, EVENT_KEY},
+{7216, 0x1a7, EVENT_KEY},
+{7232, 128, EVENT_KEY},
+{7241, 166, EVENT_KEY},
+{7252, 0x271, EVENT_KEY},
+{7268, 0x172, EVENT_KEY},
+{7281, 205, EVENT_KEY},
+{7293, 227, EVENT_KEY},
+{7313, 99, EVENT_KEY},
+{7323, 20, EVENT_KEY},
+{7329, 15, EVENT_KEY},
+{7337, 0x180, EVENT_KEY},
+{7346, 0x241, EVENT_KEY},
+{7362, 0x19e, EVENT_KEY},
+{7371, 0x184, EVENT_KEY},
+{7380, 0x167, EVENT_KEY},
+{7389, 0x171, EVENT_KEY},
+{7399, 0x214, EVENT_KEY},
+{7416, 0x213, EVENT_KEY},
+{7432, 0x212, EVENT_KEY},
+{7452, 0x285, EVENT_KEY},
+{7474, 0x182, EVENT_KEY},
+{7484, 0x179, EVENT_KEY},
+{7491, 0x17a, EVENT_KEY},
+{7499, 0x19f, EVENT_KEY},
+{7508, 22, EVENT_KEY},
+{7514, 131, EVENT_KEY},
+{7523, 240, EVENT_KEY},
+{7535, 0x274, EVENT_KEY},
+{7546, 103, EVENT_KEY},
+{7553, 239, EVENT_KEY},
+{7561, 47, EVENT_KEY},
+{7567, 0x17b, EVENT_KEY},
+{7575, 0x17c, EVENT_KEY},
+{7584, 0x168, EVENT_KEY},
+{7595, 0x189, EVENT_KEY},
+{7605, 0x1a0, EVENT_KEY},
+{7620, 241, EVENT_KEY},
+{7635, 242, EVENT_KEY},
+{7650, 0x273, EVENT_KEY},
+{7658, 0x246, EVENT_KEY},
+{7675, 0x1ac, EVENT_KEY},
+{7689, 114, EVENT_KEY},
+{7704, 115, EVENT_KEY},
+{7717, 17, EVENT_KEY},
+{7723, 143, EVENT_KEY},
+{7734, KEY_WWAN, EVENT_KEY},
+{7744, 238, EVENT_KEY},
+{7753, 0x1a5, EVENT_KEY},
+{7771, 0x211, EVENT_KEY},
+{7786, 246, EVENT_KEY},
+{7795, 150, EVENT_KEY},
+{7803, 45, EVENT_KEY},
+{7809, 147, EVENT_KEY},
+{7818, 21, EVENT_KEY},
+{7824, 0x190, EVENT_KEY},
+{7835, 124, EVENT_KEY},
+{7843, 44, EVENT_KEY},
+{7849, 85, EVENT_KEY},
+{7868, KEY_FULL_SCREEN, EVENT_KEY},
+{7877, 0x1a2, EVENT_KEY},
+{7888, 0x1a3, EVENT_KEY},
+{7900, 0x1a4, EVENT_KEY},
+{7914, 0x09, EVENT_SW},
+{7935, (SW_MAX+1), EVENT_SW},
+{7942, 0x05, EVENT_SW},
+{7950, 0x0b, EVENT_SW},
+{7969, 0x02, EVENT_SW},
+{7989, 0x07, EVENT_SW},
+{8013, 0x0a, EVENT_SW},
+{8029, 0x00, EVENT_SW},
+{8036, 0x0d, EVENT_SW},
+{8053, 0x06, EVENT_SW},
+{8071, 0x10, EVENT_SW},
+{8088, 0x10, EVENT_SW},
+{8095, 0x04, EVENT_SW},
+{8116, 0x0e, EVENT_SW},
+{8131, 0x0f, EVENT_SW},
+{8147, SW_RFKILL_ALL, EVENT_SW},
+{8156, 0x03, EVENT_SW},
+{8170, 0x0c, EVENT_SW},
+{8185, 0x01, EVENT_SW},
+{8200, 0x08, EVENT_SW},
+};
+
+const uint16_t linux_key_names[KEY_CNT] = {
+	[0] = 6618,
+	[1] = 3277,
+	[2] = 1625,
+	[3] = 1677,
+	[4] = 1683,
+	[5] = 1701,
+	[6] = 1707,
+	[7] = 1713,
+	[8] = 1719,
+	[9] = 1725,
+	[10] = 1731,
+	[11] = 1619,
+	[12] = 5591,
+	[13] = 3267,
+	[14] = 2053,
+	[15] = 7329,
+	[16] = 6491,
+	[17] = 7717,
+	[18] = 3159,
+	[19] = 6510,
+	[20] = 7323,
+	[21] = 7818,
+	[22] = 7508,
+	[23] = 4087,
+	[24] = 6083,
+	[25] = 6138,
+	[26] = 4823,
+	[27] = 6688,
+	[28] = 3249,
+	[29] = 4837,
+	[30] = 1737,
+	[31] = 6837,
+	[32] = 2898,
+	[33] = 3303,
+	[34] = 3904,
+	[35] = 3968,
+	[36] = 4145,
+	[37] = 4163,
+	[38] = 4774,
+	[39] = 7011,
+	[40] = 1835,
+	[41] = 3948,
+	[42] = 4863,
+	[43] = 2039,
+	[44] = 7843,
+	[45] = 7803,
+	[46] = 2465,
+	[47] = 7561,
+	[48] = 2024,
+	[49] = 5679,
+	[50] = 4969,
+	[51] = 2772,
+	[52] = 3113,
+	[53] = 7118,
+	[54] = 6731,
+	[55] = 4615,
+	[56] = 4811,
+	[57] = 7181,
+	[58] = 2632,
+	[59] = 3309,
+	[60] = 3396,
+	[61] = 3443,
+	[62] = 3450,
+	[63] = 3457,
+	[64] = 3464,
+	[65] = 3471,
+	[66] = 3478,
+	[67] = 3485,
+	[68] = 3316,
+	[69] = 6071,
+	[70] = 6936,
+	[71] = 4591,
+	[72] = 4599,
+	[73] = 4607,
+	[74] = 4706,
+	[75] = 4567,
+	[76] = 4575,
+	[77] = 4583,
+	[78] = 4718,
+	[79] = 4543,
+	[80] = 4551,
+	[81] = 4559,
+	[82] = 4535,
+	[83] = 4642,
+	[85] = 7849,
+	[86] = 1631,
+	[87] = 3324,
+	[88] = 3332,
+	[89] = 6774,
+	[90] = 4169,
+	[91] = 4045,
+	[92] = 4034,
+	[93] = 4182,
+	[94] = 5657,
+	[95] = 4676,
+	[96] = 4652,
+	[97] = 6703,
+	[98] = 4762,
+	[99] = 7313,
+	[100] = 6675,
+	[101] = 4921,
+	[102] = 4058,
+	[103] = 7546,
+	[104] = 6157,
+	[105] = 4802,
+	[106] = 6665,
+	[107] = 3241,
+	[108] = 3121,
+	[109] = 6144,
+	[110] = 4113,
+	[111] = 2940,
+	[112] = 4975,
+	[113] = 5670,
+	[114] = 7689,
+	[115] = 7704,
+	[116] = 6296,
+	[117] = 4664,
+	[118] = 4729,
+	[119] = 6178,
+	[120] = 6869,
+	[121] = 4630,
+	[122] = 3974,
+	[123] = 4015,
+	[124] = 7835,
+	[125] = 4850,
+	[126] = 6717,
+	[127] = 2782,
+	[128] = 7232,
+	[129] = 1766,
+	[130] = 6473,
+	[131] = 7514,
+	[132] = 3878,
+	[133] = 2864,
+	[134] = 6118,
+	[135] = 6168,
+	[136] = 3559,
+	[137] = 2873,
+	[138] = 4025,
+	[139] = 5548,
+	[140] = 2471,
+	[141] = 7047,
+	[142] = 7128,
+	[143] = 7723,
+	[144] = 3538,
+	[145] = 7034,
+	[146] = 2951,
+	[147] = 7809,
+	[148] = 6421,
+	[149] = 6431,
+	[150] = 7795,
+	[151] = 5647,
+	[152] = 2761,
+	[153] = 6795,
+	[154] = 2881,
+	[155] = 5458,
+	[156] = 2116,
+	[157] = 2794,
+	[158] = 2030,
+	[159] = 3819,
+	[160] = 2741,
+	[161] = 3185,
+	[162] = 3197,
+	[163] = 5738,
+	[164] = 6282,
+	[165] = 6347,
+	[166] = 7241,
+	[167] = 6544,
+	[168] = 6643,
+	[169] = 6224,
+	[170] = 4137,
+	[171] = 2807,
+	[172] = 4067,
+	[173] = 6572,
+	[174] = 3294,
+	[175] = 5630,
+	[176] = 3165,
+	[177] = 6951,
+	[178] = 6921,
+	[179] = 4690,
+	[180] = 4745,
+	[181] = 5712,
+	[182] = 6563,
+	[183] = 3340,
+	[184] = 3348,
+	[185] = 3356,
+	[186] = 3364,
+	[187] = 3372,
+	[188] = 3380,
+	[189] = 3388,
+	[190] = 3403,
+	[191] = 3411,
+	[192] = 3419,
+	[193] = 3427,
+	[194] = 3435,
+	[200] = 6260,
+	[201] = 6188,
+	[202] = 6441,
+	[203] = 6451,
+	[204] = 1776,
+	[205] = 7281,
+	[206] = 2731,
+	[207] = 6251,
+	[208] = 3492,
+	[209] = 2067,
+	[210] = 6385,
+	[211] = 4080,
+	[212] = 2493,
+	[213] = 7171,
+	[214] = 6497,
+	[215] = 3214,
+	[216] = 2694,
+	[217] = 6964,
+	[218] = 2818,
+	[219] = 3547,
+	[220] = 7206,
+	[221] = 7057,
+	[222] = 1812,
+	[223] = 2621,
+	[224] = 2140,
+	[225] = 2159,
+	[226] = 5493,
+	[227] = 7293,
+	[228] = 4220,
+	[229] = 4203,
+	[230] = 4239,
+	[231] = 7025,
+	[232] = 6608,
+	[233] = 3831,
+	[234] = 6860,
+	[235] = 3088,
+	[236] = 2081,
+	[237] = 2102,
+	[238] = 7744,
+	[239] = 7553,
+	[240] = 7523,
+	[241] = 7620,
+	[242] = 7635,
+	[243] = 2196,
+	[244] = 2176,
+	[245] = 3072,
+	[246] = 7786,
+	[247] = 6654,
+	[248] = 5579,
+	[0x100] = 1,
+	[0x101] = 7,
+	[0x102] = 13,
+	[0x103] = 19,
+	[0x104] = 25,
+	[0x105] = 31,
+	[0x106] = 37,
+	[0x107] = 43,
+	[0x108] = 49,
+	[0x109] = 55,
+	[0x110] = 302,
+	[0x111] = 371,
+	[0x112] = 311,
+	[0x113] = 392,
+	[0x114] = 229,
+	[0x115] = 239,
+	[0x116] = 73,
+	[0x117] = 456,
+	[0x120] = 761,
+	[0x121] = 465,
+	[0x122] = 475,
+	[0x123] = 719,
+	[0x124] = 727,
+	[0x125] = 360,
+	[0x126] = 82,
+	[0x127] = 91,
+	[0x128] = 101,
+	[0x129] = 111,
+	[0x12a] = 121,
+	[0x12b] = 131,
+	[0x12f] = 147,
+	[0x130] = 401,
+	[0x131] = 220,
+	[0x132] = 141,
+	[0x133] = 350,
+	[0x134] = 1582,
+	[0x135] = 1613,
+	[0x136] = 508,
+	[0x137] = 746,
+	[0x138] = 515,
+	[0x139] = 753,
+	[0x13a] = 381,
+	[0x13b] = 411,
+	[0x13c] = 331,
+	[0x13d] = 486,
+	[0x13e] = 497,
+	[0x140] = 620,
+	[0x141] = 684,
+	[0x142] = 541,
+	[0x143] = 633,
+	[0x144] = 523,
+	[0x145] = 575,
+	[0x146] = 605,
+	[0x147] = 591,
+	[0x148] = 666,
+	[0x149] = 444,
+	[0x14a] = 736,
+	[0x14b] = 421,
+	[0x14c] = 432,
+	[0x14d] = 556,
+	[0x14e] = 700,
+	[0x14f] = 649,
+	[0x150] = 263,
+	[0x151] = 277,
+	[0x160] = 6089,
+	[0x161] = 6975,
+	[0x162] = 3920,
+	[0x163] = 2703,
+	[0x164] = 6306,
+	[0x165] = 6127,
+	[0x166] = 4104,
+	[0x167] = 7380,
+	[0x168] = 7584,
+	[0x169] = 1864,
+	[0x16a] = 6461,
+	[0x16b] = 2652,
+	[0x16c] = 3524,
+	[0x16d] = 3259,
+	[0x16e] = 6483,
+	[0x16f] = 5571,
+	[0x170] = 4780,
+	[0x171] = 7389,
+	[0x172] = 7268,
+	[0x173] = 1825,
+	[0x174] = 3888,
+	[0x175] = 5621,
+	[0x176] = 4522,
+	[0x177] = 1876,
+	[0x178] = 6217,
+	[0x179] = 7484,
+	[0x17a] = 7491,
+	[0x17b] = 7567,
+	[0x17c] = 7575,
+	[0x17d] = 6843,
+	[0x17e] = 6851,
+	[0x17f] = 2645,
+	[0x180] = 7337,
+	[0x181] = 6534,
+	[0x182] = 7474,
+	[0x183] = 6271,
+	[0x184] = 7371,
+	[0x185] = 3151,
+	[0x186] = 2016,
+	[0x187] = 5639,
+	[0x188] = 1963,
+	[0x189] = 7595,
+	[0x18a] = 3040,
+	[0x18b] = 4949,
+	[0x18c] = 5539,
+	[0x18d] = 2480,
+	[0x18e] = 6555,
+	[0x18f] = 3958,
+	[0x190] = 7824,
+	[0x191] = 2093,
+	[0x192] = 2680,
+	[0x193] = 2664,
+	[0x194] = 3568,
+	[0x195] = 4793,
+	[0x196] = 1743,
+	[0x197] = 5729,
+	[0x198] = 6631,
+	[0x199] = 7138,
+	[0x19a] = 7066,
+	[0x19b] = 2130,
+	[0x19c] = 6334,
+	[0x19d] = 3015,
+	[0x19e] = 7362,
+	[0x19f] = 7499,
+	[0x1a0] = 7605,
+	[0x1a1] = 3910,
+	[0x1a2] = 7877,
+	[0x1a3] = 7888,
+	[0x1a4] = 7900,
+	[0x1a5] = 7753,
+	[0x1a6] = 3174,
+	[0x1a7] = 7216,
+	[0x1a8] = 3929,
+	[0x1a9] = 6317,
+	[0x1aa] = 2927,
+	[0x1ab] = 5720,
+	[0x1ac] = 7675,
+	[0x1ad] = 1750,
+	[0x1ae] = 5557,
+	[0x1af] = 3054,
+	[0x1b0] = 7191,
+	[0x1b1] = 4958,
+	[0x1b2] = 3102,
+	[0x1b3] = 3285,
+	[0x1b4] = 3847,
+	[0x1b5] = 3861,
+	[0x1b6] = 2830,
+	[0x1b7] = 5503,
+	[0x1b8] = 1660,
+	[0x1b9] = 1641,
+	[0x1ba] = 4093,
+	[0x1bc] = 5786,
+	[0x1bd] = 6234,
+	[0x1be] = 3998,
+	[0x1bf] = 4934,
+	[0x1c0] = 2966,
+	[0x1c1] = 2978,
+	[0x1c2] = 4124,
+	[0x1c3] = 2990,
+	[0x1d0] = 3596,
+	[0x1d1] = 3648,
+	[0x1d2] = 3668,
+	[0x1d3] = 3711,
+	[0x1d4] = 3721,
+	[0x1d5] = 3731,
+	[0x1d6] = 3741,
+	[0x1d7] = 3751,
+	[0x1d8] = 3761,
+	[0x1d9] = 3771,
+	[0x1da] = 3781,
+	[0x1db] = 3678,
+	[0x1dc] = 3689,
+	[0x1dd] = 3700,
+	[0x1de] = 3603,
+	[0x1df] = 3612,
+	[0x1e0] = 3630,
+	[0x1e1] = 3639,
+	[0x1e2] = 3659,
+	[0x1e3] = 3810,
+	[0x1e4] = 3621,
+	[0x1e5] = 3791,
+	[0x1f1] = 2317,
+	[0x1f2] = 2344,
+	[0x1f3] = 2357,
+	[0x1f4] = 2370,
+	[0x1f5] = 2383,
+	[0x1f6] = 2396,
+	[0x1f7] = 2409,
+	[0x1f8] = 2422,
+	[0x1f9] = 2435,
+	[0x1fa] = 2330,
+	[0x200] = 5810,
+	[0x201] = 5824,
+	[0x202] = 5868,
+	[0x203] = 5882,
+	[0x204] = 5896,
+	[0x205] = 5910,
+	[0x206] = 5924,
+	[0x207] = 5938,
+	[0x208] = 5952,
+	[0x209] = 5966,
+	[0x20a] = 6054,
+	[0x20b] = 6036,
+	[0x20c] = 5980,
+	[0x20d] = 5994,
+	[0x20e] = 6008,
+	[0x20f] = 6022,
+	[0x210] = 2520,
+	[0x211] = 7771,
+	[0x212] = 7432,
+	[0x213] = 7416,
+	[0x214] = 7399,
+	[0x215] = 2584,
+	[0x216] = 2602,
+	[0x217] = 2570,
+	[0x218] = 2504,
+	[0x219] = 2537,
+	[0x21a] = 2553,
+	[0x21b] = 1925,
+	[0x21c] = 1907,
+	[0x21d] = 1942,
+	[0x21e] = 4903,
+	[0x220] = 208,
+	[0x221] = 165,
+	[0x222] = 179,
+	[0x223] = 193,
+	[0x230] = 1797,
+	[0x231] = 6814,
+	[0x232] = 6584,
+	[0x240] = 2448,
+	[0x241] = 7346,
+	[0x242] = 4151,
+	[0x243] = 2847,
+	[0x244] = 1850,
+	[0x245] = 6905,
+	[0x246] = 7658,
+	[0x247] = 1893,
+	[0x248] = 4412,
+	[0x249] = 3224,
+	[0x24a] = 3003,
+	[0x250] = 2256,
+	[0x260] = 4359,
+	[0x261] = 4306,
+	[0x262] = 4383,
+	[0x263] = 4330,
+	[0x264] = 4254,
+	[0x265] = 4280,
+	[0x266] = 6761,
+	[0x267] = 6746,
+	[0x268] = 4891,
+	[0x269] = 4877,
+	[0x26a] = 6781,
+	[0x26b] = 5520,
+	[0x26c] = 5838,
+	[0x26d] = 5853,
+	[0x26e] = 1973,
+	[0x26f] = 1689,
+	[0x270] = 5768,
+	[0x271] = 7252,
+	[0x272] = 6200,
+	[0x273] = 7650,
+	[0x274] = 7535,
+	[0x275] = 3508,
+	[0x276] = 7147,
+	[0x277] = 2918,
+	[0x278] = 6096,
+	[0x279] = 6395,
+	[0x27a] = 6986,
+	[0x27b] = 5751,
+	[0x27c] = 6364,
+	[0x27d] = 1988,
+	[0x27e] = 5467,
+	[0x27f] = 7163,
+	[0x280] = 5685,
+	[0x281] = 3578,
+	[0x282] = 7095,
+	[0x283] = 3130,
+	[0x284] = 6516,
+	[0x285] = 7452,
+	[0x286] = 2713,
+	[0x287] = 7078,
+	[0x288] = 5699,
+	[0x289] = 2236,
+	[0x290] = 4985,
+	[0x291] = 5116,
+	[0x292] = 5247,
+	[0x293] = 5270,
+	[0x294] = 5281,
+	[0x295] = 5292,
+	[0x296] = 5303,
+	[0x297] = 5314,
+	[0x298] = 5325,
+	[0x299] = 4996,
+	[0x29a] = 5008,
+	[0x29b] = 5020,
+	[0x29c] = 5032,
+	[0x29d] = 5044,
+	[0x29e] = 5056,
+	[0x29f] = 5068,
+	[0x2a0] = 5080,
+	[0x2a1] = 5092,
+	[0x2a2] = 5104,
+	[0x2a3] = 5127,
+	[0x2a4] = 5139,
+	[0x2a5] = 5151,
+	[0x2a6] = 5163,
+	[0x2a7] = 5175,
+	[0x2a8] = 5187,
+	[0x2a9] = 5199,
+	[0x2aa] = 5211,
+	[0x2ab] = 5223,
+	[0x2ac] = 5235,
+	[0x2ad] = 5258,
+	[0x2b0] = 5413,
+	[0x2b1] = 5436,
+	[0x2b2] = 5390,
+	[0x2b3] = 5336,
+	[0x2b4] = 5354,
+	[0x2b5] = 5372,
+	[0x2b8] = 4432,
+	[0x2b9] = 4450,
+	[0x2ba] = 4468,
+	[0x2bb] = 4486,
+	[0x2bc] = 4504,
+	[0x2c0] = 791,
+	[0x2c1] = 1010,
+	[0x2c2] = 1229,
+	[0x2c3] = 1448,
+	[0x2c4] = 1487,
+	[0x2c5] = 1506,
+	[0x2c6] = 1525,
+	[0x2c7] = 1544,
+	[0x2c8] = 1563,
+	[0x2c9] = 810,
+	[0x2ca] = 830,
+	[0x2cb] = 850,
+	[0x2cc] = 870,
+	[0x2cd] = 890,
+	[0x2ce] = 910,
+	[0x2cf] = 930,
+	[0x2d0] = 950,
+	[0x2d1] = 970,
+	[0x2d2] = 990,
+	[0x2d3] = 1029,
+	[0x2d4] = 1049,
+	[0x2d5] = 1069,
+	[0x2d6] = 1089,
+	[0x2d7] = 1109,
+	[0x2d8] = 1129,
+	[0x2d9] = 1149,
+	[0x2da] = 1169,
+	[0x2db] = 1189,
+	[0x2dc] = 1209,
+	[0x2dd] = 1248,
+	[0x2de] = 1268,
+	[0x2df] = 1288,
+	[0x2e0] = 1308,
+	[0x2e1] = 1328,
+	[0x2e2] = 1348,
+	[0x2e3] = 1368,
+	[0x2e4] = 1388,
+	[0x2e5] = 1408,
+	[0x2e6] = 1428,
+	[0x2e7] = 1467,
+};
+
+const uint16_t linux_sw_names[SW_CNT] = {
+	[0x00] = 8029,
+	[0x01] = 8185,
+	[0x02] = 7969,
+	[0x03] = 8156,
+	[0x04] = 8095,
+	[0x05] = 7942,
+	[0x06] = 8053,
+	[0x07] = 7989,
+	[0x08] = 8200,
+	[0x09] = 7914,
+	[0x0a] = 8013,
+	[0x0b] = 7950,
+	[0x0c] = 8170,
+	[0x0d] = 8036,
+	[0x0e] = 8116,
+	[0x0f] = 8131,
+	[0x10] = 8071,
 };
 
 #endif
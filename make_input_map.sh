@@ -1,9 +1,48 @@
 #!/bin/sh
+# Usage: make_input_map.sh /usr/include/linux/input-event-codes.h > input_map.h
 
 if [ ! -e $1 ]; then
 	echo "$1 is missing!"
 	exit 1
 fi
+
+# Prints "name value type" for every BTN_, KEY_ and SW_ define
+codes() {
+	grep -E '^#define[[:space:]]+(BTN|KEY)_' $1 | awk '{ print $2, $3, "EVENT_KEY" }'
+	grep -E '^#define[[:space:]]+SW_' $1 | awk '{ print $2, $3, "EVENT_SW" }'
+}
+
+# Same, sorted by name (in C locale) for binary search
+sorted() {
+	codes $1 | LC_ALL=C sort -k1,1
+}
+
+# Prints "name offset value type", offset is where the name is in
+# linux_input_names, 0 is the empty string there so it means "no name"
+offsets() {
+	sorted $1 | awk '
+		BEGIN { off = 1 }
+		{ print $1, off, $2, $3; off += length($1) + 1 }
+		END { if (off > 65535) exit 1 }'
+}
+
+# Code to name index, only numeric values (no aliases and limits), the last
+# name defined for a code wins (i.e. BTN_LEFT over BTN_MOUSE)
+names() {
+	{ offsets $1; echo "-"; codes $1; } | awk -v type=$2 '
+		!codes && $0 == "-" { codes = 1; next }
+		!codes { off[$1] = $2; next }
+		$3 == type && $2 ~ /^(0x[0-9a-fA-F]+|[0-9]+)$/ && $1 !~ /_(MAX|CNT)$/ {
+			if (!($2 in name))
+				order[n++] = $2
+			name[$2] = $1
+		}
+		END {
+			for (i = 0; i < n; i++)
+				print "\t[" order[i] "] = " off[name[order[i]]] ","
+		}'
+}
+
 echo "/* This file is autogenerated, DO NOT EDIT! */"
 echo "#ifndef INPUT_MAP_H"
 echo "#define INPUT_MAP_H"
@@ -17,10 +56,26 @@ echo " *  the Free Software Foundation; either version 2 of the License, or"
 echo " *  (at your option) any later version."
 echo " */"
 echo ""
-echo "struct uint_str_tuple linux_input_map[] = {"
-grep BTN_ $1 | awk '{ print "{\""$2"\"" ", " $3 "},"}'
-grep KEY_ $1 | awk '{ print "{\""$2"\"" ", " $3 "},"}'
-grep SW_ $1 | awk '{ print "{\""$2"\"" ", " $3 "},"}'
+echo "/* All names back to back, tables below hold offsets into it instead of"
+echo " * pointers, so they are half the size and need no relocations. It is"
+echo " * longer than C99 requires compilers to support, hence __extension__"
+echo " */"
+sorted $1 | awk '
+	BEGIN { printf "const char linux_input_names[] = __extension__ \"\\0\"" }
+	{ printf "\n\t\"%s\\0\"", $1 }
+	END { print ";" }'
+echo ""
+echo "/* Sorted by name (in C locale) for binary search */"
+echo "const struct input_map_entry linux_input_map[] = {"
+offsets $1 | awk '{ print "{" $2 ", " $3 ", " $4 "}," }'
+echo "};"
+echo ""
+echo "const uint16_t linux_key_names[KEY_CNT] = {"
+names $1 EVENT_KEY
+echo "};"
+echo ""
+echo "const uint16_t linux_sw_names[SW_CNT] = {"
+names $1 EVENT_SW
 echo "};"
 echo ""
 echo "#endif"
@@ -20,300 +20,735 @@
 
 #include <errno.h>
 #include <fcntl.h>
-#include <poll.h>
 #include <signal.h>
-#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
 #include <sys/stat.h>
 #include <sys/time.h>
+#include <sys/timerfd.h>
 #include <sys/types.h>
 
 #include <linux/input.h>
 #include <linux/uinput.h>
 
+#include "ctl.h"
+#include "devices.h"
+#include "emul.h"
 #include "mouse-emul.h"
 #include "options.h"
+#include "readers.h"
+#include "record.h"
+#include "rt.h"
+#include "sink.h"
+#include "stats.h"
+#include "uring.h"
 
-#define MAX_ACCEL 24
-#define ACCEL_DIVIDOR 3
-#define POLL_TIMEOUT_MS 1000
-/* Max input devs */
-#define MAX_DEVS 64
+#define MAX_EPOLL_EVENTS 64
 
 static int want_to_exit;
+static int epoll_fd = -1;
+/* Some device has events left after its read budget */
+static int devices_pending;
+static struct emul emul;
+static struct sink sink_kbd, sink_mouse, sink_abs;
+/* uinput fds, or output file. Absolute pointer is there only if config
+ * has screen size
+ */
+static int ufile_kbd = -1, ufile_mouse = -1, ufile_abs = -1;
+static FILE *output_file;
+/* What emulated kbd was created with, and absolute pointer's screen size */
+static struct caps kbd_created;
+static int abs_width, abs_height;
+
+static void process_signal(struct source *src);
+static void process_motion(struct source *src);
+static void process_macro(struct source *src);
+static void process_timers(struct source *src);
+static void process_device(struct source *src);
+static void kbd_update(void);
+static void abs_update(void);
+
+static struct source signal_src = { .fd = -1, .process = process_signal };
+static struct source motion_src = { .fd = -1, .process = process_motion };
+static struct source macro_src = { .fd = -1, .process = process_macro };
+static struct source timer_src = { .fd = -1, .process = process_timers };
+
+/* Called when motion timer fires */
+static void process_motion(struct source *src)
+{
+	uint64_t ticks;
+	struct timespec ts;
+	struct timeval now;
+
+	if (read(src->fd, &ticks, sizeof(ticks)) != sizeof(ticks))
+		return;
+
+	if (!motion_active(&emul))
+		return;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now.tv_sec = ts.tv_sec;
+	now.tv_usec = ts.tv_nsec / 1000;
+	motion_tick(&emul, &now, ticks);
+}
+
+/* Next frame of a running macro is due */
+static void process_macro(struct source *src)
+{
+	uint64_t expirations;
+	struct timespec ts;
+	struct timeval now;
+
+	if (read(src->fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+		return;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now.tv_sec = ts.tv_sec;
+	now.tv_usec = ts.tv_nsec / 1000;
+	macro_tick(&emul, &now);
+}
 
-void sighandler(int signum)
+/* A tap-hold key may have timed out */
+static void process_timers(struct source *src)
 {
-	switch (signum) {
+	uint64_t expirations;
+	struct timespec ts;
+	struct timeval now;
+
+	if (read(src->fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+		return;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now.tv_sec = ts.tv_sec;
+	now.tv_usec = ts.tv_nsec / 1000;
+	timers_tick(&emul, &now);
+}
+
+/* Device is going away, release whatever was held on it */
+static void release_keys(struct evdev *dev)
+{
+	struct input_event evt;
+	int code;
+
+	memset(&evt, 0, sizeof(evt));
+	evt.type = EV_KEY;
+	for (code = 0; code < KEY_CNT; code++) {
+		if (!test_bit(code, dev->keys))
+			continue;
+		evt.code = code;
+		process_event(&emul, &evt);
+	}
+	emul_flush(&emul);
+}
+
+/* Re-read config, or switch to another one if name is given */
+static int reload_config(const char *name)
+{
+	struct timespec start, end;
+	unsigned long keys[NLONGS(KEY_CNT)];
+
+	/* Running macro, tap-hold keys and bindings of held keys are in the
+	 * old config
+	 */
+	macro_finish(&emul);
+	tap_hold_finish(&emul);
+	devices_keys(keys);
+	keys_finish(&emul, keys);
+	emul_flush(&emul);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if (options_reload(name)) {
+		warn("Config reload failed, keeping the old one\n");
+		return -1;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	/* Direction keys and motion rate may have changed, and layers */
+	motion_stop(&emul);
+	layers_reset(&emul);
+	/* And there may be new match rules */
+	devices_scan();
+	/* New bindings may send keys kbd was not created with, and the
+	 * screen size may have changed
+	 */
+	kbd_update();
+	abs_update();
+
+	warn("Config reloaded in %ld us\n",
+	     (end.tv_sec - start.tv_sec) * 1000000L +
+	     (end.tv_nsec - start.tv_nsec) / 1000);
+
+	return 0;
+}
+
+/* Signals are delivered through signalfd, so they are handled between
+ * read batches and never interrupt event processing
+ */
+static void process_signal(struct source *src)
+{
+	struct signalfd_siginfo si;
+
+	if (read(src->fd, &si, sizeof(si)) != sizeof(si))
+		return;
+
+	switch (si.ssi_signo) {
 	case SIGTERM:
 	case SIGINT:
 		want_to_exit = 1;
 		break;
+	case SIGHUP:
+		reload_config(NULL);
+		break;
+	case SIGUSR1:
+		stats_dump();
+		break;
+	case SIGUSR2:
+		stats_reset();
+		break;
 	default:
-		/* TODO: print some usefull info on SIGUSR1/SIGUSR2 */
-		warn("Got signal %d\n", signum);
+		warn("Got signal %d\n", si.ssi_signo);
 		break;
 
 	}
 }
 
-void die(const char *errstr, ...)
+int loop_add(struct source *src, uint32_t events)
 {
-	va_list ap;
+	struct epoll_event ev;
+
+	memset(&ev, 0, sizeof(ev));
+	ev.events = events;
+	ev.data.ptr = src;
+	if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, src->fd, &ev)) {
+		warn("Could not add fd %d to epoll: %s\n", src->fd, strerror(errno));
+		return -1;
+	}
 
-	va_start(ap, errstr);
-	vfprintf(stderr, errstr, ap);
-	va_end(ap);
-	exit(EXIT_FAILURE);
+	return 0;
 }
 
-void warn(const char *errstr, ...)
+void loop_del(struct source *src)
 {
-	va_list ap;
-
-	va_start(ap, errstr);
-	vfprintf(stderr, errstr, ap);
-	va_end(ap);
+	epoll_ctl(epoll_fd, EPOLL_CTL_DEL, src->fd, NULL);
 }
 
-int send_event(int ufile, __u16 type, __u16 code, __s32 value)
+/* Events from a device, read here or by its reader thread */
+static void handle_events(struct evdev *dev, struct input_event *ev, int cnt)
 {
-	struct input_event event;
+	int i;
+
+	stats_batch(cnt);
+	record_events(ev, cnt);
+	for (i = 0; i < cnt; i++) {
+		if (ev[i].type == EV_KEY && ev[i].code < KEY_CNT) {
+			if (ev[i].value == 1)
+				set_bit(ev[i].code, dev->keys);
+			else if (ev[i].value == 0)
+				clear_bit(ev[i].code, dev->keys);
+		}
+		if (EV_KEY == ev[i].type || EV_SW == ev[i].type)
+			stats_event_in(&ev[i].time);
+	}
+	process_events(&emul, ev, cnt);
+}
 
-	memset(&event, 0, sizeof(event));
-	event.type = type;
-	event.code = code;
-	event.value = value;
+/* Devices are edge-triggered, so read until there's nothing left. Unless
+ * read_budget is used up: then the device is pending, epoll won't report it
+ * again, so it's read in the next iteration after others had their turn
+ */
+static void process_device(struct source *src)
+{
+	struct evdev *dev = (struct evdev *)src;
+	struct input_event ev[64];
+	int budget = read_budget;
+	size_t len;
+	ssize_t cnt;
+
+	dev->pending = 0;
+	while (budget > 0) {
+		len = budget < 64 ? budget : 64;
+		cnt = read(src->fd, ev, len * sizeof(struct input_event));
+		stats.reads++;
+		if (cnt == -1) {
+			if (errno == EAGAIN)
+				break;
+			if (errno == EINTR)
+				continue;
+			if (errno != ENODEV)
+				warn("Read from %s returned error: %s\n", dev->path,
+				     strerror(errno));
+			device_remove(dev);
+			return;
+		}
+		/* Shouldn't happen with evdev, but would spin forever */
+		if (cnt == 0) {
+			device_remove(dev);
+			return;
+		}
+		handle_events(dev, ev, cnt / sizeof(struct input_event));
+		budget -= cnt / sizeof(struct input_event);
+	}
+	if (budget <= 0) {
+		dev->pending = 1;
+		devices_pending = 1;
+	}
+}
 
-	if (write(ufile, &event, sizeof(event)) != sizeof(event)) {
-		warn("Error during event sending");
-		return -1;
+static void process_pending(void)
+{
+	struct evdev *dev, *next;
+
+	devices_pending = 0;
+	/* Removed device goes to the dead list */
+	for (dev = evdevs; dev; dev = next) {
+		next = dev->next;
+		if (dev->src.fd != -1 && dev->pending)
+			process_device(&dev->src);
 	}
+}
 
-	return 0;
+static int uinput_open(void)
+{
+	int fd;
+
+	fd = open("/dev/input/uinput", O_WRONLY | O_CLOEXEC);
+	if (fd == -1)
+		fd = open("/dev/uinput", O_WRONLY | O_CLOEXEC);
+
+	if (fd == -1)
+		die("Could not open uinput: %s\n", strerror(errno));
+
+	return fd;
 }
 
-void process_event(int ufile_kbd, int ufile_mouse, struct input_event *evt)
+/* Absolute axes get 0 to width - 1 and height - 1 ranges, if given */
+static void uinput_create(int fd, const char *name, int width, int height)
 {
-	static int enabled, tmp_enabled;
-	static int dx, dy;
-	static int moving, accel;
-	uint32_t code;
-
-	/* We're grabbing toggle key, no need to emit event for it */
-	if ((evt->code == (toggle_code & CODE_MASK)) && (evt->value == 1)) {
-		enabled ^= evt->value;
-		return;
+	struct uinput_setup setup;
+	struct uinput_abs_setup abs;
+	struct uinput_user_dev uinp;
+
+	memset(&setup, 0, sizeof(setup));
+	setup.id.version = 4;
+	setup.id.bustype = BUS_USB;
+	strncpy(setup.name, name, sizeof(setup.name) - 1);
+	/* Kernels before 4.5 only take the legacy write */
+	if (ioctl(fd, UI_DEV_SETUP, &setup) < 0) {
+		memset(&uinp, 0, sizeof(uinp));
+		uinp.id = setup.id;
+		strncpy(uinp.name, name, sizeof(uinp.name) - 1);
+		uinp.absmax[ABS_X] = width ? width - 1 : 0;
+		uinp.absmax[ABS_Y] = height ? height - 1 : 0;
+		if (write(fd, &uinp, sizeof(uinp)) == -1)
+			die("Error during writing to %s: %s\n", name, strerror(errno));
+	} else if (width && height) {
+		memset(&abs, 0, sizeof(abs));
+		abs.code = ABS_X;
+		abs.absinfo.maximum = width - 1;
+		if (ioctl(fd, UI_ABS_SETUP, &abs) < 0)
+			die("Error during %s axis setup: %s\n", name, strerror(errno));
+		abs.code = ABS_Y;
+		abs.absinfo.maximum = height - 1;
+		if (ioctl(fd, UI_ABS_SETUP, &abs) < 0)
+			die("Error during %s axis setup: %s\n", name, strerror(errno));
 	}
 
-	if (evt->code == (mod_code & CODE_MASK))
-		tmp_enabled = (evt->value == 1);
+	if (ioctl(fd, UI_DEV_CREATE) < 0)
+		die("Error during %s input device creation: %s\n", name,
+		    strerror(errno));
+}
 
-	/* No emulation enabled? Passthrough event */
-	if (!enabled && !tmp_enabled) {
-		send_event(ufile_kbd, EV_KEY, evt->code, evt->value);
-		send_event(ufile_kbd, EV_SYN, SYN_REPORT, 0);
-		return;
+/* Fail early: opened before input devices are grabbed */
+static void outputs_open(void)
+{
+	if (strcmp(output_name, "uinput") == 0) {
+		ufile_kbd = uinput_open();
+		ufile_mouse = uinput_open();
+		sink_uinput(&sink_kbd, "kbd", ufile_kbd);
+		sink_uinput(&sink_mouse, "mouse", ufile_mouse);
+		if (config->screen_width && config->screen_height) {
+			ufile_abs = uinput_open();
+			sink_uinput(&sink_abs, "abs", ufile_abs);
+		} else
+			sink_null(&sink_abs, "abs");
+		/* Written in one go at the end of the batch, if enabled */
+		uring_sink(&sink_kbd);
+		uring_sink(&sink_mouse);
+		uring_sink(&sink_abs);
+	} else if (strcmp(output_name, "null") == 0) {
+		sink_null(&sink_kbd, "kbd");
+		sink_null(&sink_mouse, "mouse");
+		sink_null(&sink_abs, "abs");
+	} else if (strncmp(output_name, "file:", 5) == 0) {
+		output_file = fopen(output_name + 5, "w");
+		if (!output_file)
+			die("Could not open %s: %s\n", output_name + 5, strerror(errno));
+		/* Line buffered, so it can be followed */
+		setvbuf(output_file, NULL, _IOLBF, 0);
+		sink_file(&sink_kbd, "kbd", output_file);
+		sink_file(&sink_mouse, "mouse", output_file);
+		sink_file(&sink_abs, "abs", output_file);
+	} else
+		die("Unknown output %s\n", output_name);
+}
+
+static void set_bits(int fd, unsigned long req, const unsigned long *bits,
+		     int cnt)
+{
+	int i;
+
+	for (i = 0; i < cnt; i++) {
+		if (test_bit(i, bits))
+			ioctl(fd, req, i);
+	}
+}
+
+/* Everything kbd may send: events of grabbed devices when passed through,
+ * what their keys are bound to in mouse-mode and layers, tap-hold keys and
+ * macros. If more devices may come, any key could
+ */
+static void kbd_caps(struct caps *caps)
+{
+	const struct action *act;
+	const struct macro_frame *frame;
+	const struct input_event *ev;
+	int i, j, l;
+
+	memset(caps, 0, sizeof(*caps));
+	if (devices_caps(caps)) {
+		set_bit(EV_KEY, caps->ev);
+		set_bit(EV_MSC, caps->ev);
+		set_bit(MSC_SCAN, caps->msc);
+		for (i = 0; i < KEY_MAX; i++)
+			set_bit(i, caps->key);
 	}
 
-	if (evt->code == up_code) {
-		if (evt->value == 0)
-			moving--;
-		else if (evt->value == 1)
-			moving++;
-		dy = evt->value == 0 ? 0 : -1;
-	} else if (evt->code == down_code) {
-		if (evt->value == 0)
-			moving--;
-		else if (evt->value == 1)
-			moving++;
-		dy = evt->value == 0 ? 0 : 1;
-	} else if (evt->code == right_code) {
-		if (evt->value == 0)
-			moving--;
-		else if (evt->value == 1)
-			moving++;
-		dx = evt->value == 0 ? 0 : 1;
-	} else if (evt->code == left_code) {
-		if (evt->value == 0)
-			moving--;
-		else if (evt->value == 1)
-			moving++;
-		dx = evt->value == 0 ? 0 : -1;
-	} else if (evt->code == lbutton_code) {
-		send_event(ufile_mouse, EV_KEY, BTN_LEFT, evt->value);
-		send_event(ufile_mouse, EV_SYN, SYN_REPORT, 0);
-	} else if (evt->code == rbutton_code) {
-		send_event(ufile_mouse, EV_KEY, BTN_RIGHT, evt->value);
-		send_event(ufile_mouse, EV_SYN, SYN_REPORT, 0);
-	} else if (evt->code == mbutton_code) {
-		send_event(ufile_mouse, EV_KEY, BTN_MIDDLE, evt->value);
-		send_event(ufile_mouse, EV_SYN, SYN_REPORT, 0);
-	} else {
-		if ((code = codes[type_linux_to_local[evt->type]][evt->code]) != 0) {
-			send_event(ufile_kbd,
-				type_local_to_linux[(code & TYPE_MASK) >> TYPE_SHIFT],
-				code & CODE_MASK, evt->value);
-			send_event(ufile_kbd, EV_SYN, SYN_REPORT, 0);
-		} else {
-			send_event(ufile_kbd, EV_KEY, evt->code, evt->value);
-			send_event(ufile_kbd, EV_SYN, SYN_REPORT, 0);
+	for (i = 0; i < KEY_CNT; i++) {
+		for (j = 0; j < EVENT_TYPES; j++) {
+			if (j == EVENT_SW && i >= SW_CNT)
+				break;
+			if (!test_bit(i, j == EVENT_KEY ? caps->key : caps->sw))
+				continue;
+			for (l = 0; l < config->layers_cnt; l++) {
+				act = &config->layers[l][j][i];
+				if (act->kind != ACTION_PASS &&
+				    act->kind != ACTION_REMAP)
+					continue;
+				set_bit(act->type, caps->ev);
+				if (act->type == EV_SW)
+					set_bit(act->code, caps->sw);
+				else
+					set_bit(act->code, caps->key);
+			}
 		}
 	}
 
-	/* Clamp value */
-	moving = moving < 0 ? 0 : moving;
-	moving = moving > 4 ? 4 : moving;
+	for (i = 0; i < config->tap_holds_cnt; i++) {
+		set_bit(config->tap_holds[i].tap, caps->key);
+		if (config->tap_holds[i].hold_kind == TAP_HOLD_KEY)
+			set_bit(config->tap_holds[i].hold, caps->key);
+	}
 
-	if (moving) {
-		if (accel < MAX_ACCEL)
-			accel++;
+	for (i = 0; i < config->macro_frames_cnt; i++) {
+		frame = &config->macro_frames[i];
+		if (frame->mouse)
+			continue;
+		for (j = 0; j < frame->cnt; j++) {
+			ev = &config->macro_events[frame->first + j];
+			if (ev->type == EV_KEY)
+				set_bit(ev->code, caps->key);
+		}
+	}
 
-		send_event(ufile_mouse, EV_REL, REL_X, dx * (1 + accel / ACCEL_DIVIDOR));
-		send_event(ufile_mouse, EV_REL, REL_Y, dy * (1 + accel / ACCEL_DIVIDOR));
-		send_event(ufile_mouse, EV_SYN, SYN_REPORT, 0);
-	} else
-		accel = 0;
+	/* Only types with codes set up here. Not EV_REP: passthrough forwards
+	 * devices' autorepeat, the kernel must not repeat keys once more. Not
+	 * EV_LED: nothing would carry LED state back to devices
+	 */
+	caps->ev[0] &= (1UL << EV_KEY) | (1UL << EV_MSC) | (1UL << EV_SW);
+	set_bit(EV_KEY, caps->ev);
 }
 
-int main(int argc, char *argv[])
+static void kbd_create(const struct caps *caps)
 {
-	int evdev[MAX_DEVS];
-	int evdev_cnt = 0;
-	int ufile_kbd, ufile_mouse, i, cnt, res;
-	struct input_event ev[64];
-	char *ptr, *next_ptr;
+	set_bits(ufile_kbd, UI_SET_EVBIT, caps->ev, EV_CNT);
+	set_bits(ufile_kbd, UI_SET_KEYBIT, caps->key, KEY_CNT);
+	set_bits(ufile_kbd, UI_SET_MSCBIT, caps->msc, MSC_CNT);
+	set_bits(ufile_kbd, UI_SET_SWBIT, caps->sw, SW_CNT);
+	uinput_create(ufile_kbd, EMU_NAME_KBD, 0, 0);
+	kbd_created = *caps;
+}
 
-	struct uinput_user_dev uinp;
+static int caps_subset(const unsigned long *bits, const unsigned long *of,
+		       size_t size)
+{
+	size_t i;
 
-	signal(SIGTERM, sighandler);
-	signal(SIGINT, sighandler);
-	signal(SIGUSR1, sighandler);
-	signal(SIGUSR2, sighandler);
+	for (i = 0; i < size / sizeof(*bits); i++) {
+		if (bits[i] & ~of[i])
+			return 0;
+	}
 
-	options_init(argc, argv);
+	return 1;
+}
 
-	ufile_kbd = open("/dev/input/uinput", O_WRONLY);
-	if (ufile_kbd == -1)
-		ufile_kbd = open("/dev/uinput", O_WRONLY);
+/* Recreate kbd if reloaded config sends keys it does not have, the kernel
+ * would drop them. Same fd, so its sink stays as it is
+ */
+static void kbd_update(void)
+{
+	struct caps caps;
 
 	if (ufile_kbd == -1)
-		die("Could not open uinput: %s\n", strerror(errno));
+		return;
 
-	ufile_mouse = open("/dev/input/uinput", O_WRONLY);
-	if (ufile_mouse == -1)
-		ufile_mouse = open("/dev/uinput", O_WRONLY);
+	kbd_caps(&caps);
+	if (caps_subset(caps.ev, kbd_created.ev, sizeof(caps.ev)) &&
+	    caps_subset(caps.key, kbd_created.key, sizeof(caps.key)) &&
+	    caps_subset(caps.msc, kbd_created.msc, sizeof(caps.msc)) &&
+	    caps_subset(caps.sw, kbd_created.sw, sizeof(caps.sw)))
+		return;
 
-	if (ufile_mouse == -1)
-		die("Could not open uinput: %s\n", strerror(errno));
+	ioctl(ufile_kbd, UI_DEV_DESTROY);
+	kbd_create(&caps);
+	warn("Emulated kbd recreated for new keys\n");
+}
 
-	next_ptr = dev_name;
-	while (next_ptr) {
-		ptr = next_ptr;
-		next_ptr = strchr(dev_name, ',');
-		if (next_ptr) {
-			*next_ptr = '\0';
-			next_ptr++;
-			if (*next_ptr == '\0')
-				next_ptr = NULL;
-		}
-		evdev[evdev_cnt] = open(ptr, O_RDONLY);
-		if (evdev[evdev_cnt] == -1) {
-			warn("Could not open %s: %s\n", dev_name, strerror(errno));
-			continue;
-		}
-		res = ioctl(evdev[evdev_cnt], EVIOCGRAB, 1);
-		if (res)
-			die("Could not grab %s: %s\n", ptr, strerror(errno));
-		evdev_cnt++;
+/* Whether a key sent to kbd gets through */
+int kbd_has_key(int code)
+{
+	return ufile_kbd == -1 || test_bit(code, kbd_created.key);
+}
+
+/* Buttons make it a pointer for udev */
+static void abs_create(void)
+{
+	ioctl(ufile_abs, UI_SET_EVBIT, EV_KEY);
+	ioctl(ufile_abs, UI_SET_EVBIT, EV_ABS);
+	ioctl(ufile_abs, UI_SET_ABSBIT, ABS_X);
+	ioctl(ufile_abs, UI_SET_ABSBIT, ABS_Y);
+	ioctl(ufile_abs, UI_SET_KEYBIT, BTN_LEFT);
+	ioctl(ufile_abs, UI_SET_KEYBIT, BTN_RIGHT);
+	ioctl(ufile_abs, UI_SET_KEYBIT, BTN_MIDDLE);
+	uinput_create(ufile_abs, EMU_NAME_ABS, config->screen_width,
+		      config->screen_height);
+	abs_width = config->screen_width;
+	abs_height = config->screen_height;
+}
+
+/* Absolute pointer comes, goes or gets new ranges with the screen size of
+ * reloaded config. Its fd stays open once there is one, io_uring writes
+ * may still be queued to it
+ */
+static void abs_update(void)
+{
+	int width = config->screen_width, height = config->screen_height;
+
+	if (ufile_kbd == -1)
+		return;
+	if (!width || !height)
+		width = height = 0;
+	if (width == abs_width && height == abs_height)
+		return;
+
+	if (abs_width)
+		ioctl(ufile_abs, UI_DEV_DESTROY);
+	/* Grid cells were of the old screen */
+	emul.grid_w = 0;
+	if (!width) {
+		abs_width = abs_height = 0;
+		sink_null(&sink_abs, "abs");
+		warn("Absolute pointer removed\n");
+		return;
 	}
-	if (!evdev_cnt)
-		die("No input devices to listen!\n");
 
-	/* Everything is ready, it's time to go into background */
-	if (background)
-		daemon(0, 1);
+	if (ufile_abs == -1)
+		ufile_abs = uinput_open();
+	sink_uinput(&sink_abs, "abs", ufile_abs);
+	uring_sink(&sink_abs);
+	abs_create();
+	warn("Absolute pointer set up for %dx%d\n", width, height);
+}
+
+static void outputs_create(void)
+{
+	struct timespec start, end;
+	struct caps caps;
 
-	/* Only keys for kbd device */ 
-	ioctl(ufile_kbd, UI_SET_EVBIT, EV_KEY);
-	ioctl(ufile_kbd, UI_SET_EVBIT, EV_REL);
-	for (i = 0; i < KEY_MAX; i++)
-		ioctl(ufile_kbd, UI_SET_KEYBIT, i);
+	if (ufile_kbd == -1)
+		return;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	/* Only what grabbed devices have, not every key there is, so
+	 * there's less to set up here and for whoever gets the device
+	 */
+	kbd_caps(&caps);
 
 	/* Mouse events for mouse device */
 	ioctl(ufile_mouse, UI_SET_EVBIT, EV_KEY);
 	ioctl(ufile_mouse, UI_SET_EVBIT, EV_REL);
 	ioctl(ufile_mouse, UI_SET_RELBIT, REL_X);
 	ioctl(ufile_mouse, UI_SET_RELBIT, REL_Y);
+	ioctl(ufile_mouse, UI_SET_RELBIT, REL_WHEEL);
+	ioctl(ufile_mouse, UI_SET_RELBIT, REL_HWHEEL);
+	ioctl(ufile_mouse, UI_SET_RELBIT, REL_WHEEL_HI_RES);
+	ioctl(ufile_mouse, UI_SET_RELBIT, REL_HWHEEL_HI_RES);
 	ioctl(ufile_mouse, UI_SET_KEYBIT, BTN_MOUSE);
 	ioctl(ufile_mouse, UI_SET_KEYBIT, BTN_LEFT);
 	ioctl(ufile_mouse, UI_SET_KEYBIT, BTN_RIGHT);
 	ioctl(ufile_mouse, UI_SET_KEYBIT, BTN_MIDDLE);
 
-	memset(&uinp, 0, sizeof(uinp));
-	uinp.id.version = 4;
-	uinp.id.bustype = BUS_USB;
-	strncpy(uinp.name, EMU_NAME_KBD, sizeof(EMU_NAME_KBD));
-	res = write(ufile_kbd, &uinp, sizeof(uinp));
-	if (res == -1)
-		die("Error during writing to ufile_kbd: %s\n", strerror(errno));
-
-	memset(&uinp, 0, sizeof(uinp));
-	uinp.id.version = 4;
-	uinp.id.bustype = BUS_USB;
-	strncpy(uinp.name, EMU_NAME_MOUSE, sizeof(EMU_NAME_MOUSE));
-	res = write(ufile_mouse, &uinp, sizeof(uinp));
-	if (res == -1)
-		die("Error during writing to ufile_mouse: %s\n", strerror(errno));
-
-	if (ioctl(ufile_kbd, UI_DEV_CREATE) < 0)
-		die("Error during kbd input device creation: %s\n", strerror(errno));
-
-	if (ioctl(ufile_mouse, UI_DEV_CREATE) < 0)
-		die("Error during mouse input device creation: %s\n", strerror(errno));
-
-	struct pollfd pollfd[evdev_cnt];
-	for (i = 0; i < evdev_cnt; i++) {
-		pollfd[i].fd = evdev[i];
-		pollfd[i].events = POLLIN;
+	kbd_create(&caps);
+	uinput_create(ufile_mouse, EMU_NAME_MOUSE, 0, 0);
+
+	/* Absolute pointer for grid warps */
+	if (ufile_abs != -1)
+		abs_create();
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	warn("Emulated devices created in %ld us\n",
+	     (end.tv_sec - start.tv_sec) * 1000000L +
+	     (end.tv_nsec - start.tv_nsec) / 1000);
+}
+
+static void outputs_close(void)
+{
+	if (ufile_kbd != -1) {
+		ioctl(ufile_kbd, UI_DEV_DESTROY);
+		ioctl(ufile_mouse, UI_DEV_DESTROY);
+		close(ufile_kbd);
+		close(ufile_mouse);
 	}
-	while (!want_to_exit) {
-		res = poll(pollfd, evdev_cnt, POLL_TIMEOUT_MS);
+	if (ufile_abs != -1) {
+		if (abs_width)
+			ioctl(ufile_abs, UI_DEV_DESTROY);
+		close(ufile_abs);
+	}
+	if (output_file)
+		fclose(output_file);
+	sink_free(&sink_kbd);
+	sink_free(&sink_mouse);
+	sink_free(&sink_abs);
+}
+
+int main(int argc, char *argv[])
+{
+	int i, res;
+	struct epoll_event events[MAX_EPOLL_EVENTS];
+	struct source *src;
+	sigset_t sigmask;
+
+	sigemptyset(&sigmask);
+	sigaddset(&sigmask, SIGTERM);
+	sigaddset(&sigmask, SIGINT);
+	sigaddset(&sigmask, SIGHUP);
+	sigaddset(&sigmask, SIGUSR1);
+	sigaddset(&sigmask, SIGUSR2);
+	sigprocmask(SIG_BLOCK, &sigmask, NULL);
+
+	options_init(argc, argv);
 
-		if (!res || res == -1)
+	epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (epoll_fd == -1)
+		die("Could not create epoll: %s\n", strerror(errno));
+
+	signal_src.fd = signalfd(-1, &sigmask, SFD_NONBLOCK | SFD_CLOEXEC);
+	if (signal_src.fd == -1 || loop_add(&signal_src, EPOLLIN))
+		die("Could not create signalfd: %s\n", strerror(errno));
+
+	if (use_uring) {
+		if (threaded)
+			die("--threads and --io-uring can't be used together\n");
+		if (uring_init(handle_events))
+			warn("io_uring is not available, using epoll\n");
+	}
+
+	outputs_open();
+
+	motion_src.fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (motion_src.fd == -1 || loop_add(&motion_src, EPOLLIN))
+		die("Could not create motion timer: %s\n", strerror(errno));
+	macro_src.fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (macro_src.fd == -1 || loop_add(&macro_src, EPOLLIN))
+		die("Could not create macro timer: %s\n", strerror(errno));
+	timer_src.fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (timer_src.fd == -1 || loop_add(&timer_src, EPOLLIN))
+		die("Could not create tap-hold timer: %s\n", strerror(errno));
+	emul_init(&emul, &sink_kbd, &sink_mouse, &sink_abs, motion_src.fd,
+		  macro_src.fd, timer_src.fd);
+
+	if (ctl_name[0])
+		ctl_init(ctl_name, &emul, reload_config);
+
+	if (record_name[0] && record_open(record_name))
+		die("Could not start recording\n");
+
+	if (emitter_cpu != -1)
+		set_cpu(pthread_self(), emitter_cpu);
+	/* Reader threads and memory locks don't survive fork */
+	if (background && (threaded || realtime)) {
+		daemon(0, 1);
+		background = 0;
+	}
+	if (realtime)
+		rt_init(realtime);
+	if (threaded)
+		readers_init(reader_cpus, handle_events);
+
+	device_removed = release_keys;
+	devices_init(dev_name, process_device);
+	if (!evdev_cnt && !config->rules_cnt)
+		die("No input devices to listen!\n");
+
+	/* Everything is ready, it's time to go into background */
+	if (background)
+		daemon(0, 1);
+
+	outputs_create();
+	stats_start();
+
+	/* Nothing to do until something happens, no timeout unless there are
+	 * events left to read or io_uring completions already reaped
+	 */
+	while (!want_to_exit) {
+		res = epoll_wait(epoll_fd, events, MAX_EPOLL_EVENTS,
+				 devices_pending || uring_ready() ? 0 : -1);
+		if (res == -1) {
+			if (errno != EINTR)
+				warn("epoll_wait failed: %s\n", strerror(errno));
 			continue;
+		}
 
-		for (i = 0; i < evdev_cnt; i++) {
-			if (pollfd[i].revents != POLLIN)
-				continue;
-			cnt = read(evdev[i], ev, sizeof(ev));
-			if (cnt == -1) {
-				warn("Read returned error: %s\n", strerror(errno));
-				break;
-			}
-			for (i = 0;
-			     i < cnt / sizeof(struct input_event);
-			     i++) {
-				/* FIXME: ugly hardcode */
-				if (EV_KEY == ev[i].type || EV_SW == ev[i].type)
-					process_event(ufile_kbd, ufile_mouse, &ev[i]);
-			}
+		for (i = 0; i < res; i++) {
+			src = events[i].data.ptr;
+			/* Device may be removed earlier in this batch */
+			if (src->fd != -1)
+				src->process(src);
 		}
+		if (devices_pending)
+			process_pending();
+		uring_process();
+		emul_flush(&emul);
+		uring_submit();
+		stats_written();
+		devices_reap();
 	}
 	warn("%s: terminating...\n", argv[0]);
-	ioctl(ufile_kbd, UI_DEV_DESTROY);
-	ioctl(ufile_mouse, UI_DEV_DESTROY);
-	close(ufile_kbd);
-	close(ufile_mouse);
-
-	for (i = 0; i < evdev_cnt; i++) {
-		res = ioctl(evdev[i], EVIOCGRAB, 0);
-		if (res)
-			warn("Could not ungrab %d device: %s\n", i, strerror(errno));
-		close(evdev[i]);
-	}
+	outputs_close();
+	close(motion_src.fd);
+	close(macro_src.fd);
+	close(timer_src.fd);
+	close(signal_src.fd);
+
+	ctl_close();
+	devices_close();
+	readers_close();
+	uring_close();
+	close(epoll_fd);
+	record_close();
 }
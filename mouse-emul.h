@@ -21,8 +21,22 @@
 #ifndef __MOUSE_EMUL_H
 #define __MOUSE_EMUL_H
 
-#define EMU_NAME_KBD "mouse-emul-kdb"
-#define EMU_NAME_MOUSE "mouse-emul-mouse"
+#define EMU_NAME_PREFIX "mouse-emul-"
+#define EMU_NAME_KBD EMU_NAME_PREFIX "kdb"
+#define EMU_NAME_MOUSE EMU_NAME_PREFIX "mouse"
+#define EMU_NAME_ABS EMU_NAME_PREFIX "abs"
+
+#include <stdint.h>
+
+/* Anything in the epoll set, epoll data points to it */
+struct source {
+	int fd;
+	void (*process)(struct source *src);
+};
+
+int loop_add(struct source *src, uint32_t events);
+void loop_del(struct source *src);
+int kbd_has_key(int code);
 
 void die(const char *errstr, ...);
 void warn(const char *errstr, ...);
@@ -18,30 +18,58 @@
  *
  */
 
+#include <ctype.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <getopt.h>
+#include <math.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #include <linux/input.h>
 
 #include "options.h"
 #include "input_map.h"
 #include "mouse-emul.h"
+#include "record.h"
+#include "stats.h"
 
 #ifndef ARRAY_SIZE
 #define ARRAY_SIZE(a) (sizeof((a)) / sizeof(*(a)))
 #endif
 
 char dev_name[4096];
+char output_name[1024];
+char ctl_name[1024];
+int threaded;
+/* Only if built with IO_URING=1, epoll is used otherwise */
+int use_uring;
+/* Where reader threads and the event loop thread go, not pinned if empty */
+char reader_cpus[256];
+int emitter_cpu = -1;
+int realtime;
+int read_budget = DEFAULT_READ_BUDGET;
 
-uint32_t left_code = KEY_LEFT, right_code = KEY_RIGHT, down_code = KEY_DOWN, up_code = KEY_UP;
-uint32_t toggle_code = KEY_OPTION, mod_code = KEY_LEFTALT;
-uint32_t lbutton_code = KEY_ENTER, mbutton_code = KEY_PLAYCD, rbutton_code = KEY_STOPCD;
 int background;
 
-uint32_t codes[EVENT_TYPES][KEY_CNT];
+static char config_name[1024];
+static int compile;
+
+/* Active config, replaced as a whole on reload */
+struct config *config;
+
+static const char *accel_curves_str[] = {
+	[ACCEL_LINEAR] = "linear",
+	[ACCEL_QUADRATIC] = "quadratic",
+	[ACCEL_EXPONENTIAL] = "exponential",
+	[ACCEL_TABLE] = "table",
+};
 
 uint16_t type_linux_to_local[EV_CNT] = {
 	[EV_KEY] = EVENT_KEY,
@@ -53,17 +81,32 @@ uint16_t type_local_to_linux[EVENT_TYPES] = {
 	[EVENT_SW] = EV_SW,
 };
 
-struct uint_str_tuple types_str[] = {
-	{ .str = "KEY_", .uint = EVENT_KEY },
-	{ .str = "SW_", .uint = EVENT_SW },
-	{ .str = "BTN_", .uint = EVENT_KEY },
-};
+static const char short_options[] = "d:c:s:r:o:tublh";
 
-static const char short_options[] = "d:c:blh";
+/* Long only options */
+enum {
+	OPT_READER_CPUS = 256,
+	OPT_EMITTER_CPU,
+	OPT_REALTIME,
+	OPT_READ_BUDGET,
+	OPT_COMPILE,
+	OPT_CONTROL,
+};
 
 static const struct option long_options[] = {
 	{"device", required_argument, NULL, 'd'},
 	{"config", required_argument, NULL, 'c'},
+	{"stats", required_argument, NULL, 's'},
+	{"record", required_argument, NULL, 'r'},
+	{"output", required_argument, NULL, 'o'},
+	{"threads", no_argument, NULL, 't'},
+	{"io-uring", no_argument, NULL, 'u'},
+	{"reader-cpus", required_argument, NULL, OPT_READER_CPUS},
+	{"emitter-cpu", required_argument, NULL, OPT_EMITTER_CPU},
+	{"realtime", optional_argument, NULL, OPT_REALTIME},
+	{"read-budget", required_argument, NULL, OPT_READ_BUDGET},
+	{"control", required_argument, NULL, OPT_CONTROL},
+	{"compile", no_argument, NULL, OPT_COMPILE},
 	{"daemon", no_argument, NULL, 'b'},
 	{"list", no_argument, NULL, 'l'},
 	{"help", no_argument, NULL, 'h'},
@@ -76,7 +119,22 @@ static void usage(int argc, char *argv[])
 	       "-d | --device name	Input device to use as source [/dev/input/event1]\n"
 	       "                	  Use comma to separate multiple devices, i.e.\n"
 	       "                	  /dev/input/event0,/dev/input/event1\n"
+	       "                	  Defaults to none if config has match rules\n"
 	       "-c | --config name	Config file [/etc/mouse-emu]\n"
+	       "-s | --stats name	Append stats to file on SIGUSR1 [stderr]\n"
+	       "-r | --record name	Record input events to file for replay\n"
+	       "-o | --output name	Where emulated events go: uinput, null or\n"
+	       "                	  file:<name> (as text) [uinput]\n"
+	       "     --read-budget n	Events read from a device before others get\n"
+	       "                	  a turn [256]\n"
+	       "-t | --threads		Read every input device in a thread of its own\n"
+	       "-u | --io-uring		Read input devices and write uinput with io_uring\n"
+	       "     --reader-cpus list	Pin reader threads to these CPUs, i.e. 2,3\n"
+	       "     --emitter-cpu n	Pin event processing thread to CPU n\n"
+	       "     --realtime[=prio]	Lock memory and run with SCHED_FIFO priority\n"
+	       "                	  prio [50], use with --emitter-cpu\n"
+	       "     --control name	Listen for control commands on this socket\n"
+	       "     --compile		Check config and compile it for faster startup\n"
 	       "-b | --daemon		Run daemon in the background\n"
 	       "-l | --list		List supported key codes\n"
 	       "-h | --help		Print this message\n", argv[0]);
@@ -86,55 +144,654 @@ static void list_keycodes(void)
 {
 	int i;
 	for (i = 0; i < ARRAY_SIZE(linux_input_map); i++) {
-		printf("%s\n", linux_input_map[i].str);
+		printf("%s\n", linux_input_names + linux_input_map[i].str);
 	}
 }
 
-/* XXX: This is definitely not an optimal solution
- * but it works only once at startup
- * so who cares?
- */
+static int input_map_cmp(const void *key, const void *entry)
+{
+	return strcmp(key, linux_input_names +
+		      ((const struct input_map_entry *)entry)->str);
+}
+
+/* linux_input_map is sorted by make_input_map.sh, so just bsearch it */
 uint32_t get_code_for_str(const char *str)
 {
-	int i;
-	uint32_t val;
+	const struct input_map_entry *entry;
 
-	for (i = 0; i < ARRAY_SIZE(linux_input_map); i++) {
-		if (strcmp(linux_input_map[i].str, str) == 0)
-			break;
-	}
-	if (i == ARRAY_SIZE(linux_input_map))
+	entry = bsearch(str, linux_input_map, ARRAY_SIZE(linux_input_map),
+			sizeof(*linux_input_map), input_map_cmp);
+	if (!entry)
 		return 0;
 
-	val = linux_input_map[i].uint;
+	return entry->code | (entry->type << TYPE_SHIFT);
+}
 
-	for (i = 0; i < ARRAY_SIZE(types_str); i++) {
-		if (strcmp(str, types_str[i].str) == 0) {
-			val |= (types_str[i].uint << TYPE_SHIFT);
-		}
-	}
+const char *get_str_for_code(uint32_t code)
+{
+	uint16_t str = 0;
+	uint16_t type = (code & TYPE_MASK) >> TYPE_SHIFT;
+
+	code &= CODE_MASK;
+	if (type == EVENT_KEY && code < ARRAY_SIZE(linux_key_names))
+		str = linux_key_names[code];
+	else if (type == EVENT_SW && code < ARRAY_SIZE(linux_sw_names))
+		str = linux_sw_names[code];
 
-	return val;
+	return str ? linux_input_names + str : "UNKNOWN";
 }
 
+/* Config is still used, but --compile refuses it */
+static int config_errors;
+#define config_error(...) (config_errors++, warn(__VA_ARGS__))
+
 #define EXTRACT_RVALUE \
 	code2 = get_code_for_str(ptr + 1); \
 	if (code2 == 0) {\
-		warn("Unknown code %s at %d\n", ptr + 1, lineno); \
+		config_error("Unknown code %s at %d\n", ptr + 1, lineno); \
 		continue; \
 	}
 
-static void parse_config(const char *filename)
+#define EXTRACT_NUMBER(min, max) \
+	num = strtol(ptr + 1, &end, 0); \
+	if (ptr[1] == '\0' || *end != '\0' || num < (min) || num > (max)) { \
+		config_error("Invalid value %s at line %d\n", ptr + 1, lineno); \
+		continue; \
+	}
+
+static int parse_accel_curve(const char *str)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(accel_curves_str); i++) {
+		if (strcmp(str, accel_curves_str[i]) == 0)
+			return i;
+	}
+
+	return -1;
+}
+
+static int parse_accel_points(struct config *cfg, char *str)
+{
+	char *tok, *end;
+	long num;
+	int cnt = 0;
+
+	for (tok = strtok(str, ","); tok; tok = strtok(NULL, ",")) {
+		num = strtol(tok, &end, 0);
+		if (*end != '\0' || num < 0 || num > MAX_SPEED)
+			return -1;
+		if (cnt == ACCEL_POINTS_MAX)
+			return -1;
+		cfg->accel_points[cnt++] = num;
+	}
+	if (cnt < 2)
+		return -1;
+
+	cfg->accel_points_cnt = cnt;
+	return 0;
+}
+
+/* Keys for all the cells, row by row from top left */
+static int parse_grid_keys(struct config *cfg, char *str)
+{
+	char *tok;
+	uint32_t code;
+	int cnt = 0;
+
+	for (tok = strtok(str, ","); tok; tok = strtok(NULL, ",")) {
+		code = get_code_for_str(tok);
+		if (!code || cnt == GRID_CELLS)
+			return -1;
+		cfg->grid_codes[cnt++] = code;
+	}
+	if (cnt != GRID_CELLS)
+		return -1;
+
+	return 0;
+}
+
+/* Rule is a comma separated list of name:<substring>, id:<vendor>[:<product>]
+ * (hex) and key:<key name> the device must have
+ */
+static int parse_match_rule(struct config *cfg, char *str)
+{
+	struct match_rule *rule;
+	char *tok;
+	unsigned int vendor, product;
+	uint32_t code;
+
+	if (cfg->rules_cnt == MAX_RULES)
+		return -1;
+	rule = &cfg->rules[cfg->rules_cnt];
+	memset(rule, 0, sizeof(*rule));
+
+	for (tok = strtok(str, ","); tok; tok = strtok(NULL, ",")) {
+		if (strncmp(tok, "name:", 5) == 0) {
+			strncpy(rule->name, tok + 5, sizeof(rule->name) - 1);
+		} else if (strncmp(tok, "id:", 3) == 0) {
+			product = 0;
+			if (sscanf(tok + 3, "%x:%x", &vendor, &product) < 1)
+				return -1;
+			rule->vendor = vendor;
+			rule->product = product;
+		} else if (strncmp(tok, "key:", 4) == 0) {
+			code = get_code_for_str(tok + 4);
+			if (!code || (code & TYPE_MASK) >> TYPE_SHIFT != EVENT_KEY)
+				return -1;
+			rule->key = code & CODE_MASK;
+		} else
+			return -1;
+	}
+
+	cfg->rules_cnt++;
+	return 0;
+}
+
+static int macro_event(struct config *cfg, uint16_t type, uint16_t code,
+		       int32_t value)
+{
+	struct input_event *ev;
+
+	if (cfg->macro_events_cnt == MACRO_EVENTS_MAX)
+		return -1;
+	ev = &cfg->macro_events[cfg->macro_events_cnt++];
+	memset(ev, 0, sizeof(*ev));
+	ev->type = type;
+	ev->code = code;
+	ev->value = value;
+
+	return 0;
+}
+
+/* Each step is a report of its own */
+static int macro_step(struct config *cfg, uint16_t type, uint16_t code,
+		      int32_t value)
+{
+	if (macro_event(cfg, type, code, value) ||
+	    macro_event(cfg, EV_SYN, SYN_REPORT, 0))
+		return -1;
+	cfg->macro_frames[cfg->macro_frames_cnt - 1].cnt += 2;
+
+	return 0;
+}
+
+/* "<trigger> <step> ...", steps are KEY (tap), +KEY (press), -KEY (release),
+ * x:<pixels>, y:<pixels> and <ms> of delay. Mouse buttons and motion go to
+ * the emulated mouse, everything else to the keyboard
+ */
+static int parse_macro(struct config *cfg, char *str)
+{
+	struct macro *macro;
+	struct macro_frame *frame = NULL;
+	int frames_cnt = cfg->macro_frames_cnt;
+	int events_cnt = cfg->macro_events_cnt;
+	int mouse, value;
+	long num, delay = 0;
+	uint16_t type;
+	uint32_t code;
+	char *tok, *end;
+
+	if (cfg->macros_cnt == MACROS_MAX)
+		return -1;
+	macro = &cfg->macros[cfg->macros_cnt];
+
+	tok = strtok(str, " \t");
+	if (!tok || !(macro->trigger = get_code_for_str(tok)))
+		return -1;
+	macro->first_frame = cfg->macro_frames_cnt;
+
+	for (tok = strtok(NULL, " \t"); tok; tok = strtok(NULL, " \t")) {
+		if (isdigit(tok[0])) {
+			num = strtol(tok, &end, 10);
+			if (*end != '\0' || num + delay > MAX_MACRO_DELAY)
+				break;
+			delay += num;
+			/* Delayed events start a new frame */
+			frame = NULL;
+			continue;
+		}
+
+		value = -1;
+		if (tok[0] == '+' || tok[0] == '-') {
+			value = tok[0] == '+';
+			tok++;
+		}
+		if (strncmp(tok, "x:", 2) == 0 || strncmp(tok, "y:", 2) == 0) {
+			num = strtol(tok + 2, &end, 10);
+			if (value != -1 || tok[2] == '\0' || *end != '\0')
+				break;
+			mouse = 1;
+			type = EV_REL;
+			code = tok[0] == 'x' ? REL_X : REL_Y;
+		} else {
+			code = get_code_for_str(tok);
+			if (!code || (code & TYPE_MASK) >> TYPE_SHIFT != EVENT_KEY)
+				break;
+			type = EV_KEY;
+			code &= CODE_MASK;
+			/* Only these are set up on the emulated mouse */
+			mouse = code == BTN_LEFT || code == BTN_RIGHT ||
+				code == BTN_MIDDLE;
+		}
+
+		if (!frame || frame->mouse != mouse) {
+			if (cfg->macro_frames_cnt == MACRO_FRAMES_MAX)
+				break;
+			frame = &cfg->macro_frames[cfg->macro_frames_cnt++];
+			frame->first = cfg->macro_events_cnt;
+			frame->cnt = 0;
+			frame->mouse = mouse;
+			frame->delay = delay;
+			delay = 0;
+		}
+
+		if (type == EV_REL) {
+			if (macro_step(cfg, type, code, num))
+				break;
+		} else if (value != -1) {
+			if (macro_step(cfg, type, code, value))
+				break;
+		} else if (macro_step(cfg, type, code, 1) ||
+			   macro_step(cfg, type, code, 0)) {
+			break;
+		}
+	}
+
+	macro->frame_cnt = cfg->macro_frames_cnt - macro->first_frame;
+	if (tok || !macro->frame_cnt) {
+		cfg->macro_frames_cnt = frames_cnt;
+		cfg->macro_events_cnt = events_cnt;
+		return -1;
+	}
+
+	cfg->macros_cnt++;
+	return 0;
+}
+
+/* Index of the layer with this name, it's added if it's not there yet */
+static int find_layer(struct config *cfg, const char *name)
+{
+	int i;
+
+	if (strlen(name) >= LAYER_NAME_MAX)
+		return -1;
+	for (i = 0; i < cfg->layers_cnt; i++) {
+		if (strcmp(cfg->layer_names[i], name) == 0)
+			return i;
+	}
+	if (cfg->layers_cnt == LAYERS_MAX)
+		return -1;
+
+	strcpy(cfg->layer_names[cfg->layers_cnt], name);
+	cfg->layer_parents[cfg->layers_cnt] = 0;
+	return cfg->layers_cnt++;
+}
+
+/* "<name> [<parent>]" starts the layer, returns its index. A layer can't
+ * end up below itself
+ */
+static int parse_layer(struct config *cfg, char *str)
+{
+	char *name, *parent;
+	int layer, up, p;
+
+	name = strtok(str, " \t");
+	parent = strtok(NULL, " \t");
+	if (!name || strtok(NULL, " \t"))
+		return -1;
+	if ((layer = find_layer(cfg, name)) < 0)
+		return -1;
+	if (!parent)
+		return layer;
+
+	if (!layer || (up = find_layer(cfg, parent)) < 0)
+		return -1;
+	for (p = up; p; p = cfg->layer_parents[p]) {
+		if (p == layer)
+			return -1;
+	}
+	cfg->layer_parents[layer] = up;
+
+	return layer;
+}
+
+/* "<key> <layer>" of a layer_hold, layer_toggle or layer_oneshot line */
+static int parse_layer_key(struct config *cfg, int kind, char *str, int from)
+{
+	struct layer_key *key;
+	char *tok, *name;
+	int to;
+
+	if (cfg->layer_keys_cnt == LAYER_KEYS_MAX)
+		return -1;
+	key = &cfg->layer_keys[cfg->layer_keys_cnt];
+
+	tok = strtok(str, " \t");
+	name = strtok(NULL, " \t");
+	if (!tok || !name || strtok(NULL, " \t"))
+		return -1;
+	if (!(key->code = get_code_for_str(tok)))
+		return -1;
+	if ((to = find_layer(cfg, name)) < 0)
+		return -1;
+
+	key->kind = kind;
+	key->from = from;
+	key->to = to;
+	cfg->layer_keys_cnt++;
+	return 0;
+}
+
+/* "<key> <tap key> <hold key, button or layer:<name>> [<ms>]" of a
+ * tap_hold line
+ */
+static int parse_tap_hold(struct config *cfg, char *str, int from)
+{
+	struct tap_hold *th;
+	char *tok[4], *end;
+	uint32_t code;
+	long num;
+	int i, layer;
+
+	if (cfg->tap_holds_cnt == TAP_HOLDS_MAX)
+		return -1;
+	th = &cfg->tap_holds[cfg->tap_holds_cnt];
+	memset(th, 0, sizeof(*th));
+
+	tok[0] = strtok(str, " \t");
+	for (i = 1; i < 4; i++)
+		tok[i] = strtok(NULL, " \t");
+	if (!tok[2] || strtok(NULL, " \t"))
+		return -1;
+
+	if (!(th->trigger = get_code_for_str(tok[0])))
+		return -1;
+	code = get_code_for_str(tok[1]);
+	if (!code || (code & TYPE_MASK) >> TYPE_SHIFT != EVENT_KEY)
+		return -1;
+	th->tap = code & CODE_MASK;
+
+	if (strncmp(tok[2], "layer:", 6) == 0) {
+		if ((layer = find_layer(cfg, tok[2] + 6)) < 0)
+			return -1;
+		th->hold_kind = TAP_HOLD_LAYER;
+		th->hold = layer;
+	} else {
+		code = get_code_for_str(tok[2]);
+		if (!code || (code & TYPE_MASK) >> TYPE_SHIFT != EVENT_KEY)
+			return -1;
+		th->hold = code & CODE_MASK;
+		/* Only these are set up on the emulated mouse */
+		if (th->hold == BTN_LEFT || th->hold == BTN_RIGHT ||
+		    th->hold == BTN_MIDDLE)
+			th->hold_kind = TAP_HOLD_BUTTON;
+	}
+
+	if (tok[3]) {
+		num = strtol(tok[3], &end, 10);
+		if (*end != '\0' || num < 1 || num > MAX_TAP_HOLD_TIMEOUT)
+			return -1;
+		th->timeout = num;
+	}
+
+	th->from = from;
+	cfg->tap_holds_cnt++;
+	return 0;
+}
+
+/* Speed in pixels per second at position x (0..1) of the ramp */
+static double accel_speed(const struct config *cfg, double x)
+{
+	const int *points = cfg->accel_points;
+	int cnt = cfg->accel_points_cnt;
+	double pos;
+	int i;
+
+	switch (cfg->accel_curve) {
+	case ACCEL_QUADRATIC:
+		x = x * x;
+		break;
+	case ACCEL_EXPONENTIAL:
+		x = (exp(ACCEL_EXP_FACTOR * x) - 1) / (exp(ACCEL_EXP_FACTOR) - 1);
+		break;
+	case ACCEL_TABLE:
+		pos = x * (cnt - 1);
+		i = (int)pos;
+		if (i >= cnt - 1)
+			return points[cnt - 1];
+		return points[i] + (points[i + 1] - points[i]) * (pos - i);
+	default:
+		break;
+	}
+
+	return cfg->min_speed + (cfg->max_speed - cfg->min_speed) * x;
+}
+
+/* Precompute per-tick displacement, so the motion path is a lookup */
+static void build_accel_table(struct config *cfg)
+{
+	int i;
+
+	if (cfg->accel_curve == ACCEL_TABLE && cfg->accel_points_cnt < 2) {
+		warn("No accel_table given, falling back to linear acceleration\n");
+		cfg->accel_curve = ACCEL_LINEAR;
+	}
+
+	for (i = 0; i < ACCEL_TABLE_SIZE; i++)
+		cfg->accel_table[i] =
+			accel_speed(cfg, (double)i / (ACCEL_TABLE_SIZE - 1)) *
+			FIXED_ONE / cfg->motion_rate;
+}
+
+/* Scrolling runs off motion ticks, only sending out every few of them */
+static void build_scroll_table(struct config *cfg)
+{
+	double speed;
+	int i;
+
+	if (cfg->scroll_rate > cfg->motion_rate)
+		cfg->scroll_rate = cfg->motion_rate;
+	/* Rounded up, so scrolling never goes faster than scroll_rate */
+	cfg->scroll_every = (cfg->motion_rate + cfg->scroll_rate - 1) /
+		cfg->scroll_rate;
+
+	for (i = 0; i < ACCEL_TABLE_SIZE; i++) {
+		speed = cfg->scroll_min_speed +
+			(double)(cfg->scroll_max_speed - cfg->scroll_min_speed) *
+			i / (ACCEL_TABLE_SIZE - 1);
+		cfg->scroll_table[i] = speed * WHEEL_NOTCH * FIXED_ONE /
+			cfg->motion_rate;
+	}
+}
+
+static struct action *bind_layer_action(struct config *cfg, int layer,
+					uint32_t code, int kind)
+{
+	struct action *act;
+
+	act = &cfg->layers[layer][(code & TYPE_MASK) >> TYPE_SHIFT][code & CODE_MASK];
+	act->kind = kind;
+	act->layer = layer;
+
+	return act;
+}
+
+/* Bindings other than remaps and layer keys are in the base layer only */
+static struct action *bind_action(struct config *cfg, uint32_t code, int kind)
+{
+	return bind_layer_action(cfg, 0, code, kind);
+}
+
+static void bind_remap(struct config *cfg, int layer, uint32_t code,
+		       uint32_t code2)
+{
+	struct action *act = bind_layer_action(cfg, layer, code, ACTION_REMAP);
+
+	act->arg = 0;
+	act->type = type_local_to_linux[(code2 & TYPE_MASK) >> TYPE_SHIFT];
+	act->code = code2 & CODE_MASK;
+}
+
+/* Keys a layer leaves alone do what they do in its parent, which is merged
+ * first. Returns with the layer complete
+ */
+static void merge_layer(struct config *cfg, int layer, uint8_t *merged)
+{
+	struct action *act;
+	int parent = cfg->layer_parents[layer];
+	int type, i;
+
+	if (merged[layer])
+		return;
+	merge_layer(cfg, parent, merged);
+
+	for (type = 0; type < EVENT_TYPES; type++) {
+		for (i = 0; i < KEY_CNT; i++) {
+			act = &cfg->layers[layer][type][i];
+			if (act->layer != layer)
+				*act = cfg->layers[parent][type][i];
+		}
+	}
+	merged[layer] = 1;
+}
+
+static void bind_move(struct config *cfg, uint32_t code, int dir)
+{
+	bind_action(cfg, code, ACTION_MOVE)->arg = dir;
+}
+
+static void bind_scroll(struct config *cfg, uint32_t code, int dir)
+{
+	/* Not bound by default */
+	if (code)
+		bind_action(cfg, code, ACTION_SCROLL)->arg = dir;
+}
+
+static void bind_button(struct config *cfg, uint32_t code, uint16_t button)
+{
+	struct action *act = bind_action(cfg, code, ACTION_BUTTON);
+
+	act->type = EV_KEY;
+	act->code = button;
+}
+
+/* Turn remaps and bindings into a single table, so handling an event is
+ * one lookup no matter how many keys are bound
+ */
+static void build_action_table(struct config *cfg)
+{
+	const struct layer_key *key;
+	struct action *act;
+	uint8_t merged[LAYERS_MAX] = { 1 };
+	uint32_t code;
+	int type, i;
+
+	for (type = 0; type < EVENT_TYPES; type++) {
+		for (i = 0; i < KEY_CNT; i++) {
+			code = cfg->codes[type][i];
+			if (code) {
+				bind_remap(cfg, 0, i | (type << TYPE_SHIFT), code);
+			} else {
+				/* Passed through events are always sent as keys */
+				act = bind_action(cfg, i | (type << TYPE_SHIFT),
+						  ACTION_PASS);
+				act->arg = 0;
+				act->type = EV_KEY;
+				act->code = i;
+			}
+		}
+	}
+
+	/* Lowest priority first, a key bound twice does what the top one says.
+	 * Toggle and mod keys keep their output for when they're passed through
+	 */
+	bind_scroll(cfg, cfg->scroll_right_code, DIR_RIGHT);
+	bind_scroll(cfg, cfg->scroll_left_code, DIR_LEFT);
+	bind_scroll(cfg, cfg->scroll_down_code, DIR_DOWN);
+	bind_scroll(cfg, cfg->scroll_up_code, DIR_UP);
+	bind_button(cfg, cfg->mbutton_code, BTN_MIDDLE);
+	bind_button(cfg, cfg->rbutton_code, BTN_RIGHT);
+	bind_button(cfg, cfg->lbutton_code, BTN_LEFT);
+	if (cfg->screen_width && cfg->screen_height) {
+		for (i = GRID_CELLS - 1; i >= 0; i--)
+			bind_action(cfg, cfg->grid_codes[i], ACTION_GRID)->arg = i;
+	}
+	bind_move(cfg, cfg->left_code, DIR_LEFT);
+	bind_move(cfg, cfg->right_code, DIR_RIGHT);
+	bind_move(cfg, cfg->down_code, DIR_DOWN);
+	bind_move(cfg, cfg->up_code, DIR_UP);
+	bind_action(cfg, cfg->mod_code, ACTION_MOD);
+	bind_action(cfg, cfg->toggle_code, ACTION_TOGGLE);
+	for (i = 0; i < cfg->layer_keys_cnt; i++) {
+		key = &cfg->layer_keys[i];
+		bind_layer_action(cfg, key->from, key->code, key->kind)->arg = key->to;
+	}
+	for (i = 0; i < cfg->tap_holds_cnt; i++) {
+		bind_layer_action(cfg, cfg->tap_holds[i].from,
+				  cfg->tap_holds[i].trigger, ACTION_TAP_HOLD)->arg = i;
+	}
+	/* Macros are the most specific binding a key can have */
+	for (i = 0; i < cfg->macros_cnt; i++)
+		bind_action(cfg, cfg->macros[i].trigger, ACTION_MACRO)->arg = i;
+
+	/* Base layer is complete as it is */
+	for (i = 1; i < cfg->layers_cnt; i++)
+		merge_layer(cfg, i, merged);
+}
+
+static void config_defaults(struct config *cfg)
+{
+	memset(cfg, 0, sizeof(*cfg));
+	cfg->left_code = KEY_LEFT;
+	cfg->right_code = KEY_RIGHT;
+	cfg->down_code = KEY_DOWN;
+	cfg->up_code = KEY_UP;
+	cfg->toggle_code = KEY_OPTION;
+	cfg->mod_code = KEY_LEFTALT;
+	cfg->lbutton_code = KEY_ENTER;
+	cfg->mbutton_code = KEY_PLAYCD;
+	cfg->rbutton_code = KEY_STOPCD;
+	cfg->motion_rate = DEFAULT_MOTION_RATE;
+	cfg->min_speed = DEFAULT_MIN_SPEED;
+	cfg->max_speed = DEFAULT_MAX_SPEED;
+	cfg->accel_time = DEFAULT_ACCEL_TIME;
+	cfg->accel_curve = ACCEL_LINEAR;
+	cfg->scroll_up_code = KEY_PAGEUP;
+	cfg->scroll_down_code = KEY_PAGEDOWN;
+	cfg->scroll_rate = DEFAULT_SCROLL_RATE;
+	cfg->scroll_min_speed = DEFAULT_SCROLL_MIN_SPEED;
+	cfg->scroll_max_speed = DEFAULT_SCROLL_MAX_SPEED;
+	cfg->scroll_accel_time = DEFAULT_SCROLL_ACCEL_TIME;
+	cfg->grid_codes[0] = KEY_KP7;
+	cfg->grid_codes[1] = KEY_KP8;
+	cfg->grid_codes[2] = KEY_KP9;
+	cfg->grid_codes[3] = KEY_KP4;
+	cfg->grid_codes[4] = KEY_KP5;
+	cfg->grid_codes[5] = KEY_KP6;
+	cfg->grid_codes[6] = KEY_KP1;
+	cfg->grid_codes[7] = KEY_KP2;
+	cfg->grid_codes[8] = KEY_KP3;
+	strcpy(cfg->layer_names[0], "base");
+	cfg->layers_cnt = 1;
+	cfg->tap_hold_timeout = DEFAULT_TAP_HOLD_TIMEOUT;
+}
+
+static int parse_config(struct config *cfg, const char *filename)
 {
 	FILE *in;
-	char line[1024], *ptr;
+	char line[1024], *ptr, *end;
 	uint32_t code, code2;
-	int lineno = 0;
+	long num;
+	/* Layer lines go to, and layers which were started */
+	unsigned int defined = 1;
+	int lineno = 0, layer = 0, i;
 
+	config_errors = 0;
 	in = fopen(filename, "r");
 	if (!in) {
 		warn("Could not open config file %s: %s\n", filename, strerror(errno));
-		return;
+		return -1;
 	}
 
 	while (fgets(line, sizeof(line), in)) {
@@ -146,60 +803,366 @@ static void parse_config(const char *filename)
 		ptr = strchr(line, '=');
 		if (ptr) {
 			*ptr = '\0';
-			if (strcmp(line, "left") == 0) {
+			if (strcmp(line, "layer") == 0) {
+				if ((num = parse_layer(cfg, ptr + 1)) < 0) {
+					config_error("Invalid layer at line %d\n", lineno);
+					continue;
+				}
+				layer = num;
+				defined |= 1 << layer;
+			} else if (strcmp(line, "layer_hold") == 0) {
+				if (parse_layer_key(cfg, ACTION_LAYER_HOLD, ptr + 1, layer)) {
+					config_error("Invalid layer key at line %d\n", lineno);
+					continue;
+				}
+			} else if (strcmp(line, "layer_toggle") == 0) {
+				if (parse_layer_key(cfg, ACTION_LAYER_TOGGLE, ptr + 1, layer)) {
+					config_error("Invalid layer key at line %d\n", lineno);
+					continue;
+				}
+			} else if (strcmp(line, "layer_oneshot") == 0) {
+				if (parse_layer_key(cfg, ACTION_LAYER_ONESHOT, ptr + 1, layer)) {
+					config_error("Invalid layer key at line %d\n", lineno);
+					continue;
+				}
+			} else if (strcmp(line, "tap_hold") == 0) {
+				if (parse_tap_hold(cfg, ptr + 1, layer)) {
+					config_error("Invalid tap-hold key at line %d\n", lineno);
+					continue;
+				}
+			} else if (layer && !get_code_for_str(line)) {
+				config_error("Only remaps, layer and tap-hold keys can be in layer %s, line %d\n",
+					     cfg->layer_names[layer], lineno);
+				continue;
+			} else if (strcmp(line, "rate") == 0) {
+				EXTRACT_NUMBER(1, MAX_MOTION_RATE);
+				cfg->motion_rate = num;
+			} else if (strcmp(line, "min_speed") == 0) {
+				EXTRACT_NUMBER(0, MAX_SPEED);
+				cfg->min_speed = num;
+			} else if (strcmp(line, "max_speed") == 0) {
+				EXTRACT_NUMBER(0, MAX_SPEED);
+				cfg->max_speed = num;
+			} else if (strcmp(line, "accel_time") == 0) {
+				EXTRACT_NUMBER(1, MAX_ACCEL_TIME);
+				cfg->accel_time = num;
+			} else if (strcmp(line, "scroll_rate") == 0) {
+				EXTRACT_NUMBER(1, MAX_MOTION_RATE);
+				cfg->scroll_rate = num;
+			} else if (strcmp(line, "scroll_min_speed") == 0) {
+				EXTRACT_NUMBER(0, MAX_SCROLL_SPEED);
+				cfg->scroll_min_speed = num;
+			} else if (strcmp(line, "scroll_max_speed") == 0) {
+				EXTRACT_NUMBER(0, MAX_SCROLL_SPEED);
+				cfg->scroll_max_speed = num;
+			} else if (strcmp(line, "scroll_accel_time") == 0) {
+				EXTRACT_NUMBER(1, MAX_ACCEL_TIME);
+				cfg->scroll_accel_time = num;
+			} else if (strcmp(line, "tap_hold_timeout") == 0) {
+				EXTRACT_NUMBER(1, MAX_TAP_HOLD_TIMEOUT);
+				cfg->tap_hold_timeout = num;
+			} else if (strcmp(line, "screen_width") == 0) {
+				EXTRACT_NUMBER(0, MAX_SCREEN_SIZE);
+				cfg->screen_width = num;
+			} else if (strcmp(line, "screen_height") == 0) {
+				EXTRACT_NUMBER(0, MAX_SCREEN_SIZE);
+				cfg->screen_height = num;
+			} else if (strcmp(line, "grid_keys") == 0) {
+				if (parse_grid_keys(cfg, ptr + 1)) {
+					config_error("Invalid grid keys at line %d\n", lineno);
+					continue;
+				}
+			} else if (strcmp(line, "accel") == 0) {
+				if ((num = parse_accel_curve(ptr + 1)) < 0) {
+					config_error("Unknown acceleration %s at line %d\n", ptr + 1, lineno);
+					continue;
+				}
+				cfg->accel_curve = num;
+			} else if (strcmp(line, "accel_table") == 0) {
+				if (parse_accel_points(cfg, ptr + 1)) {
+					config_error("Invalid acceleration table at line %d\n", lineno);
+					continue;
+				}
+			} else if (strcmp(line, "match") == 0) {
+				if (parse_match_rule(cfg, ptr + 1)) {
+					config_error("Invalid match rule at line %d\n", lineno);
+					continue;
+				}
+			} else if (strcmp(line, "macro") == 0) {
+				if (parse_macro(cfg, ptr + 1)) {
+					config_error("Invalid macro at line %d\n", lineno);
+					continue;
+				}
+			} else if (strcmp(line, "left") == 0) {
 				EXTRACT_RVALUE;
-				left_code = code2;
+				cfg->left_code = code2;
 			} else if (strcmp(line, "right") == 0) {
 				EXTRACT_RVALUE;
-				right_code = code2;
+				cfg->right_code = code2;
 			} else if (strcmp(line, "up") == 0) {
 				EXTRACT_RVALUE;
-				up_code = code2;
+				cfg->up_code = code2;
 			} else if (strcmp(line, "down") == 0) {
 				EXTRACT_RVALUE;
-				down_code = code2;
+				cfg->down_code = code2;
+			} else if (strcmp(line, "scroll_up") == 0) {
+				EXTRACT_RVALUE;
+				cfg->scroll_up_code = code2;
+			} else if (strcmp(line, "scroll_down") == 0) {
+				EXTRACT_RVALUE;
+				cfg->scroll_down_code = code2;
+			} else if (strcmp(line, "scroll_left") == 0) {
+				EXTRACT_RVALUE;
+				cfg->scroll_left_code = code2;
+			} else if (strcmp(line, "scroll_right") == 0) {
+				EXTRACT_RVALUE;
+				cfg->scroll_right_code = code2;
 			} else if (strcmp(line, "toggle") == 0) {
 				EXTRACT_RVALUE;
-				toggle_code = code2;
+				cfg->toggle_code = code2;
 			} else if (strcmp(line, "mod") == 0) {
 				EXTRACT_RVALUE;
-				mod_code = code2;
+				cfg->mod_code = code2;
 			} else if (strcmp(line, "lbutton") == 0) {
 				EXTRACT_RVALUE;
-				lbutton_code = code2;
+				cfg->lbutton_code = code2;
 			} else if (strcmp(line, "rbutton") == 0) {
 				EXTRACT_RVALUE;
-				rbutton_code = code2;
+				cfg->rbutton_code = code2;
 			} else if (strcmp(line, "mbutton") == 0) {
 				EXTRACT_RVALUE;
-				mbutton_code = code2;
+				cfg->mbutton_code = code2;
 			} else {
 				code = get_code_for_str(line);
 				if (code != 0) {
 					EXTRACT_RVALUE;
-					printf("mapping code %x to code %x\n", code, code2);
-					codes[(code & TYPE_MASK) >> TYPE_SHIFT][code & CODE_MASK] = code2;
+					if (layer) {
+						printf("mapping %s to %s in layer %s\n",
+						       get_str_for_code(code),
+						       get_str_for_code(code2),
+						       cfg->layer_names[layer]);
+						bind_remap(cfg, layer, code, code2);
+						continue;
+					}
+					printf("mapping %s to %s\n", get_str_for_code(code),
+					       get_str_for_code(code2));
+					cfg->codes[(code & TYPE_MASK) >> TYPE_SHIFT][code & CODE_MASK] = code2;
 				} else {
-					warn("Uknown code %s at line %d\n", line, lineno);
+					config_error("Uknown code %s at line %d\n", line, lineno);
 				}
 			}
 		} else {
-			warn("Syntax error at line %d\n", lineno);
+			config_error("Syntax error at line %d\n", lineno);
 			continue;
 		}
 	}
 
+	/* Switched to, but never started, i.e. a typo */
+	for (i = 0; i < cfg->layers_cnt; i++) {
+		if (!(defined & (1 << i)))
+			config_error("Layer %s is not defined\n", cfg->layer_names[i]);
+	}
+
 	fclose(in);
+
+	return 0;
 }
 
-void options_init(int argc, char *argv[])
+/* Parse config into a new table off to the side. If the file can't be
+ * read, NULL is returned unless defaults are acceptable
+ */
+static struct config *config_load(const char *filename, int allow_defaults)
 {
-	int i;
-	char config_name[1024];
+	struct config *cfg;
+
+	cfg = malloc(sizeof(*cfg));
+	if (!cfg)
+		die("Could not allocate config: %s\n", strerror(errno));
 
-	for (i = 0; i < EVENT_TYPES; i++)
-		memset(codes[i], 0, sizeof(codes[i]));
-	strcpy(dev_name, "/dev/input/event1");
+	config_defaults(cfg);
+	if (parse_config(cfg, filename) && !allow_defaults) {
+		free(cfg);
+		return NULL;
+	}
+	build_accel_table(cfg);
+	build_scroll_table(cfg);
+	build_action_table(cfg);
+
+	return cfg;
+}
+
+/* FNV-1a */
+static uint64_t config_checksum(const struct config *cfg)
+{
+	const unsigned char *ptr = (const unsigned char *)cfg;
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	size_t i;
+
+	for (i = 0; i < sizeof(*cfg); i++) {
+		hash ^= ptr[i];
+		hash *= 0x100000001b3ULL;
+	}
+
+	return hash;
+}
+
+static void image_name(char *name, size_t size, const char *filename)
+{
+	snprintf(name, size, "%s" CONFIG_IMAGE_SUFFIX, filename);
+}
+
+/* Write the image next to the text config, replacing the old one at once,
+ * so running instances keep their mapping
+ */
+static void config_compile(const char *filename)
+{
+	struct config_image hdr;
+	struct config *cfg;
+	struct stat st;
+	char name[sizeof(config_name) + 8], tmp[sizeof(name) + 4];
+	FILE *out;
+
+	cfg = config_load(filename, 0);
+	if (!cfg || config_errors)
+		die("Config %s has errors, not compiled\n", filename);
+	if (stat(filename, &st))
+		die("Could not stat %s: %s\n", filename, strerror(errno));
+
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, CONFIG_IMAGE_MAGIC, CONFIG_IMAGE_MAGIC_LEN);
+	hdr.header_size = sizeof(hdr);
+	hdr.config_size = sizeof(*cfg);
+	hdr.mtime_sec = st.st_mtim.tv_sec;
+	hdr.mtime_nsec = st.st_mtim.tv_nsec;
+	hdr.text_size = st.st_size;
+	hdr.checksum = config_checksum(cfg);
+
+	image_name(name, sizeof(name), filename);
+	snprintf(tmp, sizeof(tmp), "%s.tmp", name);
+	out = fopen(tmp, "w");
+	if (!out)
+		die("Could not open %s: %s\n", tmp, strerror(errno));
+	if (fwrite(&hdr, sizeof(hdr), 1, out) != 1 ||
+	    fwrite(cfg, sizeof(*cfg), 1, out) != 1 || fclose(out)) {
+		unlink(tmp);
+		die("Could not write %s: %s\n", tmp, strerror(errno));
+	}
+	if (rename(tmp, name)) {
+		unlink(tmp);
+		die("Could not rename %s: %s\n", tmp, strerror(errno));
+	}
+	free(cfg);
+	printf("Compiled %s into %s\n", filename, name);
+}
+
+/* Compiled config, if there's one matching the text config. It's mapped
+ * read-only and shared, so it's in the page cache once for all instances
+ */
+static struct config *config_map(const char *filename, size_t *len)
+{
+	const struct config_image *hdr;
+	struct stat text_st, st;
+	char name[sizeof(config_name) + 8];
+	void *ptr;
+	int fd;
+
+	image_name(name, sizeof(name), filename);
+	fd = open(name, O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return NULL;
+
+	if (fstat(fd, &st) || stat(filename, &text_st) ||
+	    st.st_size != sizeof(*hdr) + sizeof(struct config)) {
+		close(fd);
+		goto stale;
+	}
+	ptr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (ptr == MAP_FAILED) {
+		warn("Could not map %s: %s\n", name, strerror(errno));
+		return NULL;
+	}
+
+	hdr = ptr;
+	if (memcmp(hdr->magic, CONFIG_IMAGE_MAGIC, CONFIG_IMAGE_MAGIC_LEN) ||
+	    hdr->header_size != sizeof(*hdr) ||
+	    hdr->config_size != sizeof(struct config) ||
+	    hdr->mtime_sec != text_st.st_mtim.tv_sec ||
+	    hdr->mtime_nsec != text_st.st_mtim.tv_nsec ||
+	    hdr->text_size != text_st.st_size ||
+	    hdr->checksum != config_checksum((const struct config *)(hdr + 1))) {
+		munmap(ptr, st.st_size);
+		goto stale;
+	}
+
+	*len = st.st_size;
+	return (struct config *)(hdr + 1);
+stale:
+	warn("Compiled config %s is stale, parsing %s\n", name, filename);
+	return NULL;
+}
+
+/* Length of the mapping if config is a compiled one, 0 if it's allocated */
+static size_t config_len;
+
+static void config_free(struct config *cfg, size_t len)
+{
+	if (len)
+		munmap((char *)cfg - sizeof(struct config_image), len);
+	else
+		free(cfg);
+}
+
+static struct config *config_open(const char *filename, int allow_defaults,
+				  size_t *len)
+{
+	struct config *cfg;
+
+	*len = 0;
+	cfg = config_map(filename, len);
+	if (cfg)
+		return cfg;
+
+	return config_load(filename, allow_defaults);
+}
+
+/* Swap in a freshly parsed config, from another file if given, old one is
+ * kept if parsing fails
+ */
+int options_reload(const char *filename)
+{
+	struct config *cfg;
+	size_t len;
+
+	if (!filename)
+		filename = config_name;
+	if (strlen(filename) >= sizeof(config_name))
+		return -1;
+
+	cfg = config_open(filename, 0, &len);
+	if (!cfg)
+		return -1;
+
+	config_free(config, config_len);
+	config = cfg;
+	config_len = len;
+	if (filename != config_name)
+		strcpy(config_name, filename);
+
+	return 0;
+}
+
+/* Config for tools which don't take daemon arguments */
+void options_load(const char *filename)
+{
+	strncpy(config_name, filename, sizeof(config_name) - 1);
+	config = config_open(config_name, 1, &config_len);
+}
+
+void options_init(int argc, char *argv[])
+{
+	dev_name[0] = '\0';
+	strcpy(output_name, "uinput");
 	strcpy(config_name, "/etc/mouse-emulrc");
 
 	for (;;) {
@@ -220,6 +1183,41 @@ void options_init(int argc, char *argv[])
 		case 'c':
 			strncpy(config_name, optarg, sizeof(config_name));
 			break;
+		case 's':
+			strncpy(stats_name, optarg, sizeof(stats_name) - 1);
+			break;
+		case 'o':
+			strncpy(output_name, optarg, sizeof(output_name) - 1);
+			break;
+		case 'r':
+			strncpy(record_name, optarg, sizeof(record_name) - 1);
+			break;
+		case 't':
+			threaded = 1;
+			break;
+		case 'u':
+			use_uring = 1;
+			break;
+		case OPT_READER_CPUS:
+			strncpy(reader_cpus, optarg, sizeof(reader_cpus) - 1);
+			break;
+		case OPT_EMITTER_CPU:
+			emitter_cpu = atoi(optarg);
+			break;
+		case OPT_READ_BUDGET:
+			read_budget = atoi(optarg);
+			if (read_budget < 1)
+				die("Invalid read budget %s\n", optarg);
+			break;
+		case OPT_REALTIME:
+			realtime = optarg ? atoi(optarg) : RT_DEFAULT_PRIO;
+			break;
+		case OPT_CONTROL:
+			strncpy(ctl_name, optarg, sizeof(ctl_name) - 1);
+			break;
+		case OPT_COMPILE:
+			compile = 1;
+			break;
 		case 'b':
 			background = 1;
 			break;
@@ -235,5 +1233,13 @@ void options_init(int argc, char *argv[])
 		}
 	}
 
-	parse_config(config_name);
+	if (compile) {
+		config_compile(config_name);
+		exit(EXIT_SUCCESS);
+	}
+	config = config_open(config_name, 1, &config_len);
+
+	/* Without match rules there's nothing to listen to but -d list */
+	if (!dev_name[0] && !config->rules_cnt)
+		strcpy(dev_name, "/dev/input/event1");
 }
@@ -24,15 +24,19 @@
 #include <stdint.h>
 
 extern char dev_name[4096];
+extern char output_name[1024];
+/* Control socket, not listening if empty */
+extern char ctl_name[1024];
+extern int threaded, emitter_cpu, use_uring;
+extern char reader_cpus[256];
+/* SCHED_FIFO priority of the event loop, 0 if not running realtime */
+extern int realtime;
 
-extern uint32_t left_code, right_code, down_code, up_code;
-extern uint32_t toggle_code, mod_code;
-extern uint32_t lbutton_code, mbutton_code, rbutton_code;
+#define RT_DEFAULT_PRIO 50
 
-struct uint_str_tuple {
-	const char *str;
-	uint16_t uint;
-};
+/* Events read from one device in a loop iteration before others get a turn */
+extern int read_budget;
+#define DEFAULT_READ_BUDGET 256
 
 /* We can do remap only for KEY, SW and BTN events */
 enum event_types {
@@ -41,18 +45,248 @@ enum event_types {
 	EVENT_TYPES,
 };
 
+struct input_map_entry {
+	uint16_t str;	/* Offset into linux_input_names */
+	uint16_t code;
+	uint16_t type;
+};
+
 #define TYPE_SHIFT 16
 #define TYPE_MASK 0xffff0000
 #define CODE_MASK 0x0000ffff
 
-/* KEY_CNT is a bit optimistic, but keeping 0xffff entries is an overkill
- * type is stored in most significant 16 bits, code in less significant
+/* Pointer motion ticks per second while direction keys are held */
+#define DEFAULT_MOTION_RATE 125
+#define MAX_MOTION_RATE 1000
+
+/* Pointer speed in pixels per second, ramped up over accel_time ms */
+#define DEFAULT_MIN_SPEED 100
+#define DEFAULT_MAX_SPEED 1200
+#define DEFAULT_ACCEL_TIME 800
+#define MAX_SPEED 20000
+#define MAX_ACCEL_TIME 60000
+
+/* Scrolling in wheel notches per second, ramped up over scroll_accel_time ms,
+ * and sent at most scroll_rate times per second
+ */
+#define DEFAULT_SCROLL_RATE 30
+#define DEFAULT_SCROLL_MIN_SPEED 2
+#define DEFAULT_SCROLL_MAX_SPEED 20
+#define DEFAULT_SCROLL_ACCEL_TIME 1000
+#define MAX_SCROLL_SPEED 1000
+
+/* Grid keys pick one of 3x3 cells of the screen, then of that cell and so
+ * on, warping an absolute pointer to its center. Screen size in pixels
+ * comes from config, there's no grid without it
+ */
+#define GRID_SIZE 3
+#define GRID_CELLS (GRID_SIZE * GRID_SIZE)
+#define MAX_SCREEN_SIZE 32767
+
+/* Hi-res wheel units in one notch, as the kernel defines them */
+#define WHEEL_NOTCH 120
+
+enum accel_curves {
+	ACCEL_LINEAR = 0,
+	ACCEL_QUADRATIC,
+	ACCEL_EXPONENTIAL,
+	ACCEL_TABLE,
+};
+
+#define ACCEL_EXP_FACTOR 4.0
+#define ACCEL_POINTS_MAX 64
+#define ACCEL_TABLE_SIZE 256
+
+/* Motion is accumulated in 16.16 fixed point to keep sub-pixel remainders */
+#define FIXED_SHIFT 16
+#define FIXED_ONE (1 << FIXED_SHIFT)
+
+/* Hotplugged devices are grabbed if they match any of these, empty fields
+ * match everything
+ */
+#define MAX_RULES 16
+
+struct match_rule {
+	char name[64];
+	uint16_t vendor, product;
+	uint16_t key;
+};
+
+/* What a key does while emulation is on, all bindings are compiled into a
+ * table of these on load. type/code is the event sent: the key itself,
+ * its remap target or a mouse button
+ */
+enum action_kinds {
+	ACTION_PASS = 0,
+	ACTION_REMAP,
+	ACTION_TOGGLE,
+	ACTION_MOD,
+	ACTION_MOVE,
+	ACTION_BUTTON,
+	ACTION_SCROLL,
+	ACTION_MACRO,
+	ACTION_GRID,
+	ACTION_LAYER_HOLD,
+	ACTION_LAYER_TOGGLE,
+	ACTION_LAYER_ONESHOT,
+	ACTION_TAP_HOLD,
+};
+
+/* arg of ACTION_GRID is the cell, row by row from top left, arg of
+ * ACTION_LAYER_* is the layer to switch to, of ACTION_TAP_HOLD the index
+ * into tap_holds
+ */
+
+/* Direction bits, arg of ACTION_MOVE and ACTION_SCROLL */
+#define DIR_UP		(1 << 0)
+#define DIR_DOWN	(1 << 1)
+#define DIR_LEFT	(1 << 2)
+#define DIR_RIGHT	(1 << 3)
+
+struct action {
+	uint8_t kind;
+	uint8_t arg;
+	/* Layer the binding comes from, 0 for the base one */
+	uint8_t layer;
+	uint16_t type, code;
+};
+
+/* Layer 0 is the base table. Others are complete tables too: bindings of
+ * the layer, and for keys it leaves alone whatever its parent layer (the
+ * base one unless given) does, merged on load. So switching layers is just
+ * picking another table
+ */
+#define LAYERS_MAX 8
+#define LAYER_NAME_MAX 16
+#define LAYER_KEYS_MAX 32
+
+struct layer_key {
+	uint32_t code;
+	/* ACTION_LAYER_*, layer it's bound in and the one it switches to */
+	uint8_t kind, from, to;
+};
+
+/* Key bound to a sequence of events. They're assembled on load into frames,
+ * each one sent to one device with a single write after delay ms
+ */
+#define MACROS_MAX 32
+#define MACRO_FRAMES_MAX 256
+#define MACRO_EVENTS_MAX 2048
+#define MAX_MACRO_DELAY 60000
+
+struct macro_frame {
+	uint16_t first, cnt;
+	uint16_t mouse;
+	uint16_t delay;
+};
+
+struct macro {
+	uint32_t trigger;
+	uint16_t first_frame, frame_cnt;
+};
+
+/* Dual-role key: a tap sends the tap key, holding it longer than timeout
+ * (or pressing another key meanwhile) holds down the hold key, mouse button
+ * or layer instead
  */
-extern uint32_t codes[EVENT_TYPES][KEY_CNT];
+#define TAP_HOLDS_MAX 32
+#define DEFAULT_TAP_HOLD_TIMEOUT 200
+#define MAX_TAP_HOLD_TIMEOUT 10000
+
+enum tap_hold_kinds {
+	TAP_HOLD_KEY = 0,
+	TAP_HOLD_BUTTON,
+	TAP_HOLD_LAYER,
+};
+
+struct tap_hold {
+	uint32_t trigger;
+	uint16_t tap, hold;
+	/* ms, 0 for tap_hold_timeout */
+	uint16_t timeout;
+	/* What hold is, and the layer the key is bound in */
+	uint8_t hold_kind, from;
+};
+
+struct config {
+	uint32_t left_code, right_code, down_code, up_code;
+	uint32_t toggle_code, mod_code;
+	uint32_t lbutton_code, mbutton_code, rbutton_code;
+	uint32_t scroll_up_code, scroll_down_code;
+	uint32_t scroll_left_code, scroll_right_code;
+
+	int motion_rate;
+	int min_speed, max_speed, accel_time, accel_curve;
+	/* User-supplied speeds for ACCEL_TABLE, evenly spread over accel_time */
+	int accel_points[ACCEL_POINTS_MAX];
+	int accel_points_cnt;
+	/* Per-tick displacement (fixed point) indexed by time since key-down */
+	int32_t accel_table[ACCEL_TABLE_SIZE];
+
+	int scroll_rate;
+	int scroll_min_speed, scroll_max_speed, scroll_accel_time;
+	/* Motion ticks between scroll events */
+	int scroll_every;
+	/* Per-tick hi-res wheel units (fixed point), linear ramp */
+	int32_t scroll_table[ACCEL_TABLE_SIZE];
+
+	int screen_width, screen_height;
+	uint32_t grid_codes[GRID_CELLS];
+
+	/* KEY_CNT is a bit optimistic, but keeping 0xffff entries is an overkill
+	 * type is stored in most significant 16 bits, code in less significant
+	 */
+	uint32_t codes[EVENT_TYPES][KEY_CNT];
+	/* Indexed by layer, local type and code of the input event */
+	struct action layers[LAYERS_MAX][EVENT_TYPES][KEY_CNT];
+	char layer_names[LAYERS_MAX][LAYER_NAME_MAX];
+	uint8_t layer_parents[LAYERS_MAX];
+	int layers_cnt;
+	struct layer_key layer_keys[LAYER_KEYS_MAX];
+	int layer_keys_cnt;
+
+	struct tap_hold tap_holds[TAP_HOLDS_MAX];
+	int tap_holds_cnt;
+	int tap_hold_timeout;
+
+	struct match_rule rules[MAX_RULES];
+	int rules_cnt;
+
+	struct macro macros[MACROS_MAX];
+	int macros_cnt;
+	struct macro_frame macro_frames[MACRO_FRAMES_MAX];
+	int macro_frames_cnt;
+	struct input_event macro_events[MACRO_EVENTS_MAX];
+	int macro_events_cnt;
+};
+
+/* Compiled config is this header followed by struct config as it is, so
+ * it's only good for the same build. Bump the version (last byte of magic)
+ * when struct config changes. Text config mtime and size tell if it's stale
+ */
+#define CONFIG_IMAGE_MAGIC "MECFG\0\0\4"
+#define CONFIG_IMAGE_MAGIC_LEN 8
+#define CONFIG_IMAGE_SUFFIX ".bin"
+
+struct config_image {
+	char magic[CONFIG_IMAGE_MAGIC_LEN];
+	uint32_t header_size, config_size;
+	int64_t mtime_sec, mtime_nsec;
+	uint64_t text_size;
+	uint64_t checksum;
+	/* Keeps config after it aligned */
+	char pad[16];
+};
+
+extern struct config *config;
 extern int background;
 extern uint16_t type_linux_to_local[EV_CNT];
 extern uint16_t type_local_to_linux[EVENT_TYPES];
 
 void options_init(int argc, char *argv[]);
+void options_load(const char *filename);
+int options_reload(const char *filename);
+uint32_t get_code_for_str(const char *str);
+const char *get_str_for_code(uint32_t code);
 
 #endif
@@ -0,0 +1,315 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "devices.h"
+#include "mouse-emul.h"
+#include "readers.h"
+
+#define READER_CPUS_MAX 64
+
+static reader_handler handler;
+static int cpus[READER_CPUS_MAX];
+static int cpus_cnt, next_cpu;
+
+static void process_wake(struct source *src);
+/* Readers poke it after putting events into their rings */
+static struct source wake_src = { .fd = -1, .process = process_wake };
+
+static void wake(void)
+{
+	uint64_t one = 1;
+
+	if (write(wake_src.fd, &one, sizeof(one)) == -1 && errno != EAGAIN)
+		warn("Could not wake event loop: %s\n", strerror(errno));
+}
+
+static int ring_full(struct reader *r)
+{
+	return r->head - __atomic_load_n(&r->tail, __ATOMIC_SEQ_CST) ==
+	       READER_RING_SIZE;
+}
+
+/* Sleep until the event loop makes room in the ring, unless told to quit
+ * meanwhile. waiting is set before the last look at tail and the loop
+ * thread looks at waiting after moving tail, so one of them sees the other
+ */
+static int ring_wait(struct reader *r, struct pollfd *stop)
+{
+	struct pollfd fds[2];
+	uint64_t val;
+
+	fds[0] = *stop;
+	fds[1].fd = r->space_fd;
+	fds[1].events = POLLIN;
+
+	while (ring_full(r)) {
+		__atomic_store_n(&r->waiting, 1, __ATOMIC_SEQ_CST);
+		if (!ring_full(r))
+			break;
+		wake();
+		if (poll(fds, 2, -1) == -1) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		if (fds[0].revents)
+			return -1;
+		if (read(r->space_fd, &val, sizeof(val)) == -1 && errno != EAGAIN)
+			return -1;
+	}
+	__atomic_store_n(&r->waiting, 0, __ATOMIC_RELAXED);
+
+	return 0;
+}
+
+static void prefault_stack(void)
+{
+	volatile char stack[READER_STACK_PREFAULT];
+
+	memset((char *)stack, 0, sizeof(stack));
+}
+
+static void *reader_thread(void *arg)
+{
+	struct reader *r = arg;
+	struct input_event ev[READER_BATCH];
+	struct pollfd fds[2];
+	ssize_t cnt;
+	int i;
+
+	fds[0].fd = r->dev->src.fd;
+	fds[0].events = POLLIN;
+	fds[1].fd = r->stop_fd;
+	fds[1].events = POLLIN;
+	prefault_stack();
+
+	for (;;) {
+		if (poll(fds, 2, -1) == -1) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+		if (fds[1].revents)
+			return NULL;
+
+		/* Drain the device, then wake the loop once */
+		for (;;) {
+			cnt = read(fds[0].fd, ev, sizeof(ev));
+			if (cnt == -1)
+				break;
+			for (i = 0; i < cnt / sizeof(struct input_event); i++) {
+				if (ring_wait(r, &fds[1]))
+					return NULL;
+				r->ring[r->head & (READER_RING_SIZE - 1)] = ev[i];
+				__atomic_store_n(&r->head, r->head + 1,
+						 __ATOMIC_RELEASE);
+			}
+		}
+		if (errno != EAGAIN && errno != EINTR)
+			break;
+		wake();
+	}
+
+	/* Device is gone, the loop thread removes it */
+	__atomic_store_n(&r->dead, 1, __ATOMIC_RELEASE);
+	wake();
+
+	return NULL;
+}
+
+int set_cpu(pthread_t thread, int cpu)
+{
+	cpu_set_t set;
+	int res;
+
+	if (cpu < 0 || cpu >= CPU_SETSIZE) {
+		warn("Invalid CPU %d\n", cpu);
+		return -1;
+	}
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	res = pthread_setaffinity_np(thread, sizeof(set), &set);
+	if (res)
+		warn("Could not pin thread to CPU %d: %s\n", cpu, strerror(res));
+
+	return res;
+}
+
+static int reader_start(struct evdev *dev)
+{
+	struct reader *r;
+	pthread_attr_t attr;
+	size_t stack = READER_STACK_SIZE;
+	int res;
+
+	r = calloc(1, sizeof(*r));
+	if (!r) {
+		warn("Could not allocate reader: %s\n", strerror(errno));
+		return -1;
+	}
+	r->dev = dev;
+	r->stop_fd = eventfd(0, EFD_CLOEXEC);
+	if (r->stop_fd == -1) {
+		warn("Could not create eventfd: %s\n", strerror(errno));
+		goto err;
+	}
+	r->space_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (r->space_fd == -1) {
+		warn("Could not create eventfd: %s\n", strerror(errno));
+		close(r->stop_fd);
+		goto err;
+	}
+
+	if (stack < PTHREAD_STACK_MIN)
+		stack = PTHREAD_STACK_MIN;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, stack);
+	res = pthread_create(&r->thread, &attr, reader_thread, r);
+	pthread_attr_destroy(&attr);
+	if (res) {
+		warn("Could not start reader for %s: %s\n", dev->path,
+		     strerror(res));
+		close(r->stop_fd);
+		close(r->space_fd);
+		goto err;
+	}
+	if (cpus_cnt)
+		set_cpu(r->thread, cpus[next_cpu++ % cpus_cnt]);
+
+	dev->reader = r;
+	return 0;
+err:
+	free(r);
+	return -1;
+}
+
+/* Unprocessed events are dropped, the device is going away anyway */
+static void reader_stop(struct evdev *dev)
+{
+	struct reader *r = dev->reader;
+	uint64_t one = 1;
+
+	if (!r)
+		return;
+
+	if (write(r->stop_fd, &one, sizeof(one)) == -1)
+		warn("Could not stop reader for %s: %s\n", dev->path,
+		     strerror(errno));
+	pthread_join(r->thread, NULL);
+	close(r->stop_fd);
+	close(r->space_fd);
+	free(r);
+	dev->reader = NULL;
+}
+
+/* Take turns between devices, so a bursting one can't hold back others.
+ * Rings are drained up to where they were when looked at, if readers have
+ * added more the loop is woken again: signals, timers and the control
+ * socket get their turn in between
+ */
+static void process_wake(struct source *src)
+{
+	struct input_event ev[READER_BATCH];
+	struct evdev *dev, *next;
+	struct reader *r;
+	unsigned int head;
+	uint64_t one = 1, val;
+	int cnt, dead, more = 0;
+
+	if (read(src->fd, &val, sizeof(val)) != sizeof(val))
+		return;
+
+	for (dev = evdevs; dev; dev = next) {
+		next = dev->next;
+		r = dev->reader;
+		if (!r)
+			continue;
+
+		/* Dead is set after the last event went in */
+		dead = __atomic_load_n(&r->dead, __ATOMIC_ACQUIRE);
+		head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+		while (r->tail != head) {
+			for (cnt = 0; cnt < READER_BATCH && r->tail + cnt != head;
+			     cnt++)
+				ev[cnt] = r->ring[(r->tail + cnt) &
+						  (READER_RING_SIZE - 1)];
+			__atomic_store_n(&r->tail, r->tail + cnt, __ATOMIC_SEQ_CST);
+			if (__atomic_exchange_n(&r->waiting, 0, __ATOMIC_SEQ_CST) &&
+			    write(r->space_fd, &one, sizeof(one)) == -1)
+				warn("Could not wake reader for %s: %s\n", dev->path,
+				     strerror(errno));
+			handler(dev, ev, cnt);
+		}
+		if (dead)
+			device_remove(dev);
+		else if (__atomic_load_n(&r->head, __ATOMIC_ACQUIRE) != head)
+			more = 1;
+	}
+
+	if (more)
+		wake();
+}
+
+static void parse_cpus(const char *str)
+{
+	char *end;
+	long cpu;
+
+	while (*str && cpus_cnt < READER_CPUS_MAX) {
+		cpu = strtol(str, &end, 10);
+		if (end == str || cpu < 0 || cpu >= CPU_SETSIZE)
+			die("Invalid CPU list %s\n", str);
+		cpus[cpus_cnt++] = cpu;
+		str = *end == ',' ? end + 1 : end;
+	}
+}
+
+/* Switch devices over to reader threads, before any device is opened */
+void readers_init(const char *cpu_list, reader_handler fn)
+{
+	handler = fn;
+	parse_cpus(cpu_list);
+
+	wake_src.fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (wake_src.fd == -1 || loop_add(&wake_src, EPOLLIN))
+		die("Could not create eventfd: %s\n", strerror(errno));
+
+	device_start = reader_start;
+	device_stop = reader_stop;
+}
+
+void readers_close(void)
+{
+	if (wake_src.fd != -1)
+		close(wake_src.fd);
+}
@@ -0,0 +1,73 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef __READERS_H
+#define __READERS_H
+
+#include <pthread.h>
+#include <linux/input.h>
+
+#include "devices.h"
+
+/* Must be a power of two */
+#define READER_RING_SIZE 1024
+/* Events taken from one device before moving on to the next one */
+#define READER_BATCH 64
+/* Reader stacks are locked too in realtime mode, so they're kept small.
+ * Part of it is touched up front, like the event loop's
+ */
+#define READER_STACK_SIZE (64 * 1024)
+#define READER_STACK_PREFAULT (32 * 1024)
+
+/* Threaded mode: every device is read by a thread of its own into a
+ * single-producer/single-consumer ring, the event loop thread is the only
+ * consumer and the only one touching emulation state and outputs
+ */
+struct reader {
+	struct evdev *dev;
+	pthread_t thread;
+	/* eventfd telling the thread to quit */
+	int stop_fd;
+
+	/* Only written by the reader thread */
+	unsigned int head;
+	/* Set by the reader thread when the device is gone */
+	int dead;
+	/* Set by the reader thread before it sleeps on a full ring, the event
+	 * loop thread clears it and pokes space_fd once it has made room
+	 */
+	int waiting;
+	int space_fd;
+	char pad[64];
+	/* Only written by the event loop thread */
+	unsigned int tail;
+
+	struct input_event ring[READER_RING_SIZE];
+};
+
+/* Events taken from a device, in the event loop thread */
+typedef void (*reader_handler)(struct evdev *dev, struct input_event *ev,
+			       int cnt);
+
+void readers_init(const char *cpus, reader_handler handler);
+void readers_close(void);
+int set_cpu(pthread_t thread, int cpu);
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mouse-emul.h"
+#include "record.h"
+
+/* Record input devices here if not empty */
+char record_name[1024];
+
+static FILE *record_file;
+
+int record_open(const char *name)
+{
+	record_file = fopen(name, "w");
+	if (!record_file) {
+		warn("Could not open %s: %s\n", name, strerror(errno));
+		return -1;
+	}
+	if (fwrite(RECORD_MAGIC, RECORD_MAGIC_LEN, 1, record_file) != 1) {
+		warn("Could not write to %s: %s\n", name, strerror(errno));
+		fclose(record_file);
+		record_file = NULL;
+		return -1;
+	}
+
+	return 0;
+}
+
+/* stdio does the buffering, so this doesn't cost a write per batch */
+void record_events(const struct input_event *ev, int cnt)
+{
+	struct record rec;
+	int i;
+
+	if (!record_file)
+		return;
+
+	for (i = 0; i < cnt; i++) {
+		rec.sec = ev[i].time.tv_sec;
+		rec.usec = ev[i].time.tv_usec;
+		rec.type = ev[i].type;
+		rec.code = ev[i].code;
+		rec.value = ev[i].value;
+		fwrite(&rec, sizeof(rec), 1, record_file);
+	}
+}
+
+void record_close(void)
+{
+	if (record_file)
+		fclose(record_file);
+	record_file = NULL;
+}
+
+struct input_event *record_load(const char *name, size_t *cnt)
+{
+	FILE *in;
+	char magic[RECORD_MAGIC_LEN];
+	struct input_event *ev = NULL;
+	struct record rec;
+	size_t size = 0;
+
+	in = fopen(name, "r");
+	if (!in)
+		die("Could not open %s: %s\n", name, strerror(errno));
+	if (fread(magic, sizeof(magic), 1, in) != 1 ||
+	    memcmp(magic, RECORD_MAGIC, RECORD_MAGIC_LEN) != 0)
+		die("%s is not a mouse-emul recording\n", name);
+
+	*cnt = 0;
+	while (fread(&rec, sizeof(rec), 1, in) == 1) {
+		if (*cnt == size) {
+			size = size ? size * 2 : 1024;
+			ev = realloc(ev, size * sizeof(*ev));
+			if (!ev)
+				die("Could not allocate events: %s\n", strerror(errno));
+		}
+		memset(&ev[*cnt], 0, sizeof(*ev));
+		ev[*cnt].time.tv_sec = rec.sec;
+		ev[*cnt].time.tv_usec = rec.usec;
+		ev[*cnt].type = rec.type;
+		ev[*cnt].code = rec.code;
+		ev[*cnt].value = rec.value;
+		(*cnt)++;
+	}
+	fclose(in);
+
+	return ev;
+}
@@ -0,0 +1,47 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef __RECORD_H
+#define __RECORD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <linux/input.h>
+
+/* Recording is this magic (last byte is format version) followed by
+ * records, all in host byte order
+ */
+#define RECORD_MAGIC "MEREC\0\0\1"
+#define RECORD_MAGIC_LEN 8
+
+struct record {
+	uint32_t sec, usec;
+	uint16_t type, code;
+	int32_t value;
+};
+
+extern char record_name[1024];
+
+int record_open(const char *name);
+void record_events(const struct input_event *ev, int cnt);
+void record_close(void);
+struct input_event *record_load(const char *name, size_t *cnt);
+
+#endif
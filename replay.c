@@ -0,0 +1,354 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/* Feeds a recording made with mouse-emul -r through the emulation
+ * pipeline into ring sinks, no uinput or input devices are needed
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/resource.h>
+
+#include <linux/input.h>
+
+#include "emul.h"
+#include "mouse-emul.h"
+#include "options.h"
+#include "record.h"
+#include "sink.h"
+#include "wheel.h"
+
+/* Only the last events are kept while benchmarking */
+#define RING_SIZE 4096
+
+/* Timer wheel benchmark: timeouts up to 10 s, a minute is run */
+#define BENCH_TIMEOUT_MAX 10000
+#define BENCH_TIMERS_MS 60000
+#define BENCH_TIMERS_ADDS 1000000
+
+static void usage(char *argv[])
+{
+	printf("Usage: %s [options] recording\n\n"
+	       "-c name	Config file [/etc/mouse-emulrc]\n"
+	       "-n runs	Replay recording that many times [1]\n"
+	       "-o name	Write output events to file, for golden comparison\n"
+	       "-g cnt	Generate a synthetic recording of cnt key presses\n"
+	       "-e	Keep emulation on while typing in generated recording\n"
+	       "-w cnt	Benchmark the timer wheel with cnt timers pending\n"
+	       "-h	Print this message\n", argv[0]);
+}
+
+static void add_event(struct timeval *time, __u16 type, __u16 code, __s32 value)
+{
+	struct input_event ev;
+
+	memset(&ev, 0, sizeof(ev));
+	ev.time = *time;
+	ev.type = type;
+	ev.code = code;
+	ev.value = value;
+	record_events(&ev, 1);
+}
+
+/* Key press or release as keyboard reports it: scancode, key and SYN */
+static void add_key(struct timeval *time, uint32_t code, int value)
+{
+	add_event(time, EV_MSC, MSC_SCAN, code & CODE_MASK);
+	add_event(time, EV_KEY, code & CODE_MASK, value);
+	add_event(time, EV_SYN, SYN_REPORT, 0);
+	time->tv_usec += 20000;
+	if (time->tv_usec >= 1000000) {
+		time->tv_sec++;
+		time->tv_usec -= 1000000;
+	}
+}
+
+static void add_keystroke(struct timeval *time, uint32_t code)
+{
+	add_key(time, code, 1);
+	add_key(time, code, 0);
+}
+
+/* Mostly typing, with a short burst of mouse mode now and then. With
+ * emulated set, it's all typed with emulation on, so every key goes
+ * through bindings lookup
+ */
+static void generate(const char *name, int cnt, int emulated)
+{
+	static const uint32_t text[] = {
+		KEY_H, KEY_E, KEY_L, KEY_L, KEY_O, KEY_SPACE, KEY_1, KEY_2,
+	};
+	struct timeval time = { 1, 0 };
+	int i, j;
+
+	if (record_open(name))
+		exit(EXIT_FAILURE);
+
+	if (emulated)
+		add_keystroke(&time, config->toggle_code);
+	for (i = 0; i < cnt; i++) {
+		if (i % 64 != 63 || emulated) {
+			add_keystroke(&time, text[i % 8]);
+			continue;
+		}
+		add_keystroke(&time, config->toggle_code);
+		add_key(&time, config->right_code, 1);
+		/* Autorepeat at 25 Hz */
+		for (j = 0; j < 10; j++)
+			add_key(&time, config->right_code, 2);
+		add_key(&time, config->right_code, 0);
+		add_keystroke(&time, config->lbutton_code);
+		add_keystroke(&time, config->toggle_code);
+	}
+
+	record_close();
+}
+
+static struct wheel bench_wheel;
+static unsigned int bench_seed = 1;
+static unsigned long long bench_expired_cnt;
+
+static uint64_t bench_timeout(void)
+{
+	bench_seed = bench_seed * 1103515245 + 12345;
+	return 1 + (bench_seed >> 8) % BENCH_TIMEOUT_MAX;
+}
+
+/* Set again, as a key pressed again would */
+static void bench_expired(struct timer *timer)
+{
+	bench_expired_cnt++;
+	timer_add(&bench_wheel, timer, bench_wheel.now + bench_timeout());
+}
+
+static double elapsed_ns(const struct timespec *start,
+			 const struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1e9 +
+		(end->tv_nsec - start->tv_nsec);
+}
+
+/* Cost of running the wheel, and of adding and removing a timer, with cnt
+ * others pending. Neither should grow with cnt
+ */
+static void bench_timers(int cnt)
+{
+	struct timer *timers, extra;
+	struct timespec start, end;
+	uint64_t now = 1;
+	double run_ns, add_ns;
+	int i;
+
+	timers = calloc(cnt, sizeof(*timers));
+	if (!timers)
+		die("Could not allocate %d timers\n", cnt);
+
+	wheel_init(&bench_wheel);
+	wheel_run(&bench_wheel, now);
+	for (i = 0; i < cnt; i++) {
+		timers[i].fn = bench_expired;
+		timer_add(&bench_wheel, &timers[i], now + bench_timeout());
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCH_TIMERS_MS; i++)
+		wheel_run(&bench_wheel, ++now);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	run_ns = elapsed_ns(&start, &end);
+
+	memset(&extra, 0, sizeof(extra));
+	extra.fn = bench_expired;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCH_TIMERS_ADDS; i++) {
+		timer_add(&bench_wheel, &extra, now + bench_timeout());
+		timer_del(&bench_wheel, &extra);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	add_ns = elapsed_ns(&start, &end);
+
+	printf("%d timers pending: add+remove %.1f ns, run %.1f ns per ms, "
+	       "%.1f ns per expired timer (%llu)\n", cnt,
+	       add_ns / BENCH_TIMERS_ADDS, run_ns / BENCH_TIMERS_MS,
+	       bench_expired_cnt ? run_ns / bench_expired_cnt : 0.0,
+	       bench_expired_cnt);
+
+	free(timers);
+}
+
+static void timeval_add_ns(struct timeval *tv, long ns)
+{
+	tv->tv_usec += ns / 1000;
+	tv->tv_sec += tv->tv_usec / 1000000;
+	tv->tv_usec %= 1000000;
+}
+
+/* Same as the daemon does, with motion timer ticks taken from timestamps */
+static void replay(struct emul *emul, struct input_event *ev, size_t cnt)
+{
+	const struct timeval *due;
+	struct timeval tick, now;
+	long period = 1000000000L / config->motion_rate;
+	size_t i, end;
+	int was_moving;
+
+	emul_reset(emul);
+	for (i = 0; i < cnt; i = end) {
+		/* One frame at a time, as the daemon gets them */
+		for (end = i; end < cnt;)
+			if (ev[end++].type == EV_SYN)
+				break;
+
+		while (motion_active(emul) && timercmp(&tick, &ev[i].time, <=)) {
+			motion_tick(emul, &tick, 1);
+			timeval_add_ns(&tick, period);
+		}
+		while ((due = macro_due(emul)) && timercmp(due, &ev[i].time, <=)) {
+			now = *due;
+			macro_tick(emul, &now);
+		}
+		/* Tap-hold keys timing out before it */
+		timers_tick(emul, &ev[i].time);
+		was_moving = motion_active(emul);
+		process_events(emul, ev + i, end - i);
+		if (!was_moving && motion_active(emul)) {
+			tick = ev[i].time;
+			timeval_add_ns(&tick, period);
+		}
+		emul_flush(emul);
+	}
+	macro_finish(emul);
+	emul_flush(emul);
+}
+
+/* One more run, untimed: kbd events go first, then mouse ones */
+static void dump_output(const char *name, struct input_event *ev, size_t cnt)
+{
+	struct sink kbd, mouse;
+	struct emul emul;
+	FILE *out, *tmp;
+	int c;
+
+	out = fopen(name, "w");
+	tmp = tmpfile();
+	if (!out || !tmp)
+		die("Could not open %s: %s\n", name, strerror(errno));
+	sink_file(&kbd, "kbd", out);
+	sink_file(&mouse, "mouse", tmp);
+	/* Absolute pointer events go with mouse ones */
+	emul_init(&emul, &kbd, &mouse, &mouse, -1, -1, -1);
+	replay(&emul, ev, cnt);
+
+	rewind(tmp);
+	while ((c = fgetc(tmp)) != EOF)
+		fputc(c, out);
+	fclose(tmp);
+	fclose(out);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *config_name = "/etc/mouse-emulrc", *out_name = NULL;
+	struct sink kbd, mouse;
+	struct emul emul;
+	struct input_event *ev;
+	struct timespec start, end;
+	struct rusage ru;
+	size_t cnt;
+	double ns;
+	int c, runs = 1, gen = 0, emulated = 0, timers = 0, i;
+
+	while ((c = getopt(argc, argv, "c:n:o:g:ew:h")) != -1) {
+		switch (c) {
+		case 'c':
+			config_name = optarg;
+			break;
+		case 'n':
+			runs = atoi(optarg);
+			break;
+		case 'o':
+			out_name = optarg;
+			break;
+		case 'g':
+			gen = atoi(optarg);
+			break;
+		case 'e':
+			emulated = 1;
+			break;
+		case 'w':
+			timers = atoi(optarg);
+			break;
+		case 'h':
+			usage(argv);
+			exit(EXIT_SUCCESS);
+		default:
+			usage(argv);
+			exit(EXIT_FAILURE);
+		}
+	}
+	if (timers > 0) {
+		bench_timers(timers);
+		exit(EXIT_SUCCESS);
+	}
+	if (optind != argc - 1 || runs < 1) {
+		usage(argv);
+		exit(EXIT_FAILURE);
+	}
+
+	options_load(config_name);
+
+	if (gen) {
+		generate(argv[optind], gen, emulated);
+		exit(EXIT_SUCCESS);
+	}
+
+	ev = record_load(argv[optind], &cnt);
+	sink_ring(&kbd, "kbd", RING_SIZE);
+	sink_ring(&mouse, "mouse", RING_SIZE);
+	emul_init(&emul, &kbd, &mouse, &mouse, -1, -1, -1);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < runs; i++)
+		replay(&emul, ev, cnt);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+	printf("%zu events in, %llu kbd and %llu mouse events out per run\n",
+	       cnt, (unsigned long long)(kbd.total / runs),
+	       (unsigned long long)(mouse.total / runs));
+	printf("%d runs: %.1f ns/event, %.0f events/s\n", runs,
+	       ns / ((double)cnt * runs), (double)cnt * runs * 1e9 / ns);
+
+	getrusage(RUSAGE_SELF, &ru);
+	printf("peak RSS: %ld kB\n", ru.ru_maxrss);
+
+	if (out_name)
+		dump_output(out_name, ev, cnt);
+
+	free(ev);
+	sink_free(&kbd);
+	sink_free(&mouse);
+
+	return 0;
+}
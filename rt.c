@@ -0,0 +1,66 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#include <errno.h>
+#include <malloc.h>
+#include <sched.h>
+#include <string.h>
+
+#include <sys/mman.h>
+
+#include "mouse-emul.h"
+#include "rt.h"
+
+static void prefault_stack(void)
+{
+	volatile char stack[RT_STACK_PREFAULT];
+
+	memset((char *)stack, 0, sizeof(stack));
+}
+
+/* Keep the event loop thread from being paged out or preempted by normal
+ * tasks. Called before reader threads are created, they inherit the policy
+ */
+void rt_init(int prio)
+{
+	struct sched_param param;
+
+	if (prio < sched_get_priority_min(SCHED_FIFO) ||
+	    prio > sched_get_priority_max(SCHED_FIFO))
+		die("Invalid realtime priority %d\n", prio);
+
+	/* Freed memory stays in the locked heap, config reload reuses it */
+	mallopt(M_TRIM_THRESHOLD, -1);
+	mallopt(M_MMAP_MAX, 0);
+
+	/* Faults in everything mapped by now: config, emulation state with its
+	 * output buffers, stats; and locks whatever is mapped later
+	 */
+	if (mlockall(MCL_CURRENT | MCL_FUTURE))
+		die("Could not lock memory: %s\n", strerror(errno));
+	prefault_stack();
+
+	memset(&param, 0, sizeof(param));
+	param.sched_priority = prio;
+	if (sched_setscheduler(0, SCHED_FIFO, &param))
+		die("Could not set SCHED_FIFO priority %d: %s\n", prio,
+		    strerror(errno));
+}
@@ -0,0 +1,120 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "mouse-emul.h"
+#include "sink.h"
+#include "stats.h"
+
+static int uinput_write(struct sink *sink, const struct input_event *ev, int cnt)
+{
+	ssize_t len = cnt * sizeof(*ev);
+
+	stats.writes++;
+	if (write(sink->fd, ev, len) != len) {
+		warn("Error during event sending: %s\n", strerror(errno));
+		return -1;
+	}
+
+	return 0;
+}
+
+static int file_write(struct sink *sink, const struct input_event *ev, int cnt)
+{
+	int i;
+
+	for (i = 0; i < cnt; i++)
+		fprintf(sink->file, "%s %d %d %d\n", sink->name, ev[i].type,
+			ev[i].code, ev[i].value);
+
+	return 0;
+}
+
+static int ring_write(struct sink *sink, const struct input_event *ev, int cnt)
+{
+	size_t part;
+
+	/* Only the tail matters if there's more than fits */
+	if (cnt > sink->ring_size) {
+		ev += cnt - sink->ring_size;
+		cnt = sink->ring_size;
+	}
+
+	part = sink->ring_size - sink->ring_head;
+	if (part > cnt)
+		part = cnt;
+	memcpy(sink->ring + sink->ring_head, ev, part * sizeof(*ev));
+	memcpy(sink->ring, ev + part, (cnt - part) * sizeof(*ev));
+	sink->ring_head = (sink->ring_head + cnt) % sink->ring_size;
+
+	return 0;
+}
+
+static int null_write(struct sink *sink, const struct input_event *ev, int cnt)
+{
+	return 0;
+}
+
+static void sink_init(struct sink *sink, const char *name,
+		      int (*write)(struct sink *, const struct input_event *, int))
+{
+	memset(sink, 0, sizeof(*sink));
+	sink->name = name;
+	sink->write = write;
+	sink->fd = -1;
+}
+
+void sink_uinput(struct sink *sink, const char *name, int fd)
+{
+	sink_init(sink, name, uinput_write);
+	sink->fd = fd;
+}
+
+void sink_file(struct sink *sink, const char *name, FILE *file)
+{
+	sink_init(sink, name, file_write);
+	sink->file = file;
+}
+
+void sink_ring(struct sink *sink, const char *name, size_t size)
+{
+	sink_init(sink, name, ring_write);
+	sink->ring = calloc(size, sizeof(*sink->ring));
+	if (!sink->ring)
+		die("Could not allocate ring: %s\n", strerror(errno));
+	sink->ring_size = size;
+}
+
+void sink_null(struct sink *sink, const char *name)
+{
+	sink_init(sink, name, null_write);
+}
+
+/* fd and file belong to the caller */
+void sink_free(struct sink *sink)
+{
+	free(sink->ring);
+	sink->ring = NULL;
+}
@@ -0,0 +1,50 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef __SINK_H
+#define __SINK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <linux/input.h>
+
+/* Where emulated devices send their events */
+struct sink {
+	int (*write)(struct sink *sink, const struct input_event *ev, int cnt);
+	const char *name;
+	/* uinput device */
+	int fd;
+	/* Text file, "<name> <type> <code> <value>" per event */
+	FILE *file;
+	/* Keeps last ring_size events */
+	struct input_event *ring;
+	size_t ring_size, ring_head;
+	/* Events written since creation */
+	uint64_t total;
+};
+
+void sink_uinput(struct sink *sink, const char *name, int fd);
+void sink_file(struct sink *sink, const char *name, FILE *file);
+void sink_ring(struct sink *sink, const char *name, size_t size);
+void sink_null(struct sink *sink, const char *name);
+void sink_free(struct sink *sink);
+
+#endif
@@ -0,0 +1,174 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <sys/resource.h>
+
+#include "mouse-emul.h"
+#include "stats.h"
+
+struct stats stats;
+/* Dump to stderr if empty */
+char stats_name[1024];
+
+static int hist_index(uint64_t val)
+{
+	int e;
+
+	if (val < HIST_SUB)
+		return val;
+
+	e = 63 - __builtin_clzll(val);
+	return (e - HIST_SUB_BITS + 1) * HIST_SUB +
+		((val >> (e - HIST_SUB_BITS)) & (HIST_SUB - 1));
+}
+
+/* Highest value which falls into bucket */
+static uint64_t hist_value(int idx)
+{
+	int e;
+
+	if (idx < HIST_SUB)
+		return idx;
+
+	e = idx / HIST_SUB + HIST_SUB_BITS - 1;
+	return ((uint64_t)(HIST_SUB + idx % HIST_SUB) << (e - HIST_SUB_BITS)) +
+		(1ULL << (e - HIST_SUB_BITS)) - 1;
+}
+
+/* Bucket bounds are reported, so never go past the max seen */
+static uint64_t hist_percentile(const uint64_t *hist, uint64_t cnt,
+				uint64_t max, double p)
+{
+	uint64_t sum = 0, target;
+	int i;
+
+	if (!cnt)
+		return 0;
+
+	target = cnt * p;
+	if (target >= cnt)
+		target = cnt - 1;
+	for (i = 0; i < HIST_BUCKETS; i++) {
+		sum += hist[i];
+		if (sum > target)
+			return hist_value(i) < max ? hist_value(i) : max;
+	}
+
+	return max;
+}
+
+/* Called from the event loop thread, right before it starts */
+void stats_start(void)
+{
+	getrusage(RUSAGE_THREAD, &stats.usage);
+}
+
+/* Everything pending was just written to uinput */
+void stats_written(void)
+{
+	struct timespec ts;
+	int64_t now, lat;
+	int i;
+
+	if (!stats.pending_cnt)
+		return;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now = (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+	for (i = 0; i < stats.pending_cnt; i++) {
+		lat = now - ((int64_t)stats.pending[i].tv_sec * 1000000 +
+			     stats.pending[i].tv_usec);
+		/* Device clock may be not monotonic, see EVIOCSCLOCKID */
+		if (lat < 0)
+			lat = 0;
+		stats.latency[hist_index(lat)]++;
+		stats.latency_cnt++;
+		if (lat > stats.latency_max)
+			stats.latency_max = lat;
+	}
+	stats.pending_cnt = 0;
+}
+
+uint64_t stats_latency(double p)
+{
+	return hist_percentile(stats.latency, stats.latency_cnt,
+			       stats.latency_max, p);
+}
+
+void stats_dump(void)
+{
+	FILE *out = stderr;
+	struct rusage usage;
+
+	if (stats_name[0]) {
+		out = fopen(stats_name, "a");
+		if (!out) {
+			warn("Could not open stats file %s: %s\n", stats_name,
+			     strerror(errno));
+			return;
+		}
+	}
+
+	fprintf(out, "events: in %llu, out %llu (passthrough %llu, remapped %llu, mouse %llu, macros %llu)\n",
+		(unsigned long long)stats.events_in,
+		(unsigned long long)stats.events_out,
+		(unsigned long long)stats.passthrough,
+		(unsigned long long)stats.remapped,
+		(unsigned long long)stats.mouse,
+		(unsigned long long)stats.macros);
+	fprintf(out, "syscalls: reads %llu, writes %llu, io_uring_enter %llu\n",
+		(unsigned long long)stats.reads,
+		(unsigned long long)stats.writes,
+		(unsigned long long)stats.uring_enters);
+	fprintf(out, "read batches: %llu, avg %.1f, max %llu events\n",
+		(unsigned long long)stats.batches,
+		stats.batches ? (double)stats.batch_events / stats.batches : 0.0,
+		(unsigned long long)stats.batch_max);
+	fprintf(out, "latency us: p50 %llu, p99 %llu, p999 %llu, max %llu (%llu events, %llu not sampled)\n",
+		(unsigned long long)hist_percentile(stats.latency, stats.latency_cnt,
+						     stats.latency_max, 0.5),
+		(unsigned long long)hist_percentile(stats.latency, stats.latency_cnt,
+						     stats.latency_max, 0.99),
+		(unsigned long long)hist_percentile(stats.latency, stats.latency_cnt,
+						     stats.latency_max, 0.999),
+		(unsigned long long)stats.latency_max,
+		(unsigned long long)stats.latency_cnt,
+		(unsigned long long)stats.latency_dropped);
+	getrusage(RUSAGE_THREAD, &usage);
+	fprintf(out, "event loop: page faults minor %ld, major %ld, involuntary context switches %ld\n",
+		usage.ru_minflt - stats.usage.ru_minflt,
+		usage.ru_majflt - stats.usage.ru_majflt,
+		usage.ru_nivcsw - stats.usage.ru_nivcsw);
+	fprintf(out, "memory: peak RSS %ld kB\n", usage.ru_maxrss);
+
+	if (out != stderr)
+		fclose(out);
+}
+
+void stats_reset(void)
+{
+	memset(&stats, 0, sizeof(stats));
+	stats_start();
+}
@@ -0,0 +1,88 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef __STATS_H
+#define __STATS_H
+
+#include <stdint.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+
+/* Log-linear histogram: every power of two is split into 2^HIST_SUB_BITS
+ * linear buckets, so relative error stays within 1/16
+ */
+#define HIST_SUB_BITS 4
+#define HIST_SUB (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS ((64 - HIST_SUB_BITS + 1) * HIST_SUB)
+
+/* Input timestamps waiting for the batch they're in to be written out */
+#define STATS_PENDING_MAX 256
+
+/* Everything is updated from the event loop thread only, and dumped from
+ * there too (signals come through signalfd), so no locking is needed
+ */
+struct stats {
+	uint64_t events_in, events_out;
+	uint64_t passthrough, remapped, mouse, macros;
+	uint64_t reads, writes, uring_enters;
+	uint64_t batches, batch_events, batch_max;
+
+	/* Input to uinput write latency, microseconds */
+	uint64_t latency[HIST_BUCKETS];
+	uint64_t latency_cnt, latency_max;
+	/* Events of batches with more than STATS_PENDING_MAX, not sampled */
+	uint64_t latency_dropped;
+
+	struct timeval pending[STATS_PENDING_MAX];
+	int pending_cnt;
+
+	/* Event loop thread usage when stats were started or reset, page
+	 * faults and preemptions since then are reported
+	 */
+	struct rusage usage;
+};
+
+extern struct stats stats;
+extern char stats_name[1024];
+
+static inline void stats_event_in(const struct timeval *time)
+{
+	stats.events_in++;
+	if (stats.pending_cnt < STATS_PENDING_MAX)
+		stats.pending[stats.pending_cnt++] = *time;
+	else
+		stats.latency_dropped++;
+}
+
+static inline void stats_batch(uint64_t cnt)
+{
+	stats.batches++;
+	stats.batch_events += cnt;
+	if (cnt > stats.batch_max)
+		stats.batch_max = cnt;
+}
+
+void stats_start(void);
+void stats_written(void);
+uint64_t stats_latency(double p);
+void stats_dump(void);
+void stats_reset(void);
+
+#endif
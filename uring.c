@@ -0,0 +1,465 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include <linux/io_uring.h>
+
+#include "devices.h"
+#include "mouse-emul.h"
+#include "stats.h"
+#include "uring.h"
+
+/* user_data of requests which are not device reads */
+#define URING_WRITE 0
+#define URING_CANCEL 1
+
+/* Read posted on a device. If the device goes away with the read in
+ * flight, it's cancelled and freed once its completion comes
+ */
+struct uring_read {
+	/* NULL once the device is stopped */
+	struct evdev *dev;
+	int posted;
+	int res;
+	struct uring_read *next;
+	struct input_event ev[URING_READ_EVENTS];
+};
+
+static void process_ring(struct source *src);
+/* Readable when there are completions */
+static struct source ring_src = { .fd = -1, .process = process_ring };
+
+static struct {
+	void *sq_ptr, *cq_ptr;
+	size_t sq_len, cq_len, sqes_len;
+	unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;
+	unsigned *cq_head, *cq_tail, *cq_mask;
+	struct io_uring_sqe *sqes;
+	struct io_uring_cqe *cqes;
+	unsigned entries;
+
+	/* Filled, but not submitted yet */
+	unsigned tail, queued;
+	/* Writes of one submission are linked, so they're done in order */
+	struct io_uring_sqe *last_write;
+	int writes_queued, writes_inflight;
+} ring;
+
+static reader_handler handler;
+/* Completed reads not handled yet, and handled ones to be posted again */
+static struct uring_read *ready, *idle;
+
+/* Data of writes in flight, reused once all of them are done */
+static struct input_event wbuf[URING_WRITE_EVENTS];
+static int wbuf_cnt;
+
+static int ring_enter(unsigned submit, unsigned wait)
+{
+	int res;
+
+	stats.uring_enters++;
+	do {
+		res = syscall(__NR_io_uring_enter, ring_src.fd, submit, wait,
+			      wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+	} while (res == -1 && errno == EINTR);
+	if (res == -1)
+		warn("io_uring_enter failed: %s\n", strerror(errno));
+
+	return res;
+}
+
+static void reap(void)
+{
+	struct io_uring_cqe *cqe;
+	struct uring_read *r;
+	unsigned head, tail;
+
+	head = *ring.cq_head;
+	tail = __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE);
+	for (; head != tail; head++) {
+		cqe = &ring.cqes[head & *ring.cq_mask];
+		if (cqe->user_data == URING_WRITE) {
+			ring.writes_inflight--;
+			if (cqe->res < 0)
+				warn("Error during event sending: %s\n",
+				     strerror(-cqe->res));
+		} else if (cqe->user_data != URING_CANCEL) {
+			r = (struct uring_read *)(uintptr_t)cqe->user_data;
+			r->posted = 0;
+			r->res = cqe->res;
+			r->next = ready;
+			ready = r;
+		}
+	}
+	__atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+
+	if (!ring.writes_inflight && !ring.writes_queued)
+		wbuf_cnt = 0;
+}
+
+static void wait_writes(void)
+{
+	while (ring.writes_inflight) {
+		if (ring_enter(0, 1) == -1) {
+			ring.writes_inflight = 0;
+			break;
+		}
+		reap();
+	}
+}
+
+/* Writes of one submission are linked, so they're done in order, but
+ * nothing orders them after the ones of a previous submission. New ones
+ * are held back until those are reaped along with reads, see
+ * process_ring(), and only waited for when there's no room left
+ */
+static int writes_held(void)
+{
+	return ring.writes_queued && ring.writes_inflight;
+}
+
+static void ring_submit(void)
+{
+	if (!ring.queued || writes_held())
+		return;
+
+	__atomic_store_n(ring.sq_tail, ring.tail, __ATOMIC_RELEASE);
+	ring_enter(ring.queued, 0);
+	ring.queued = 0;
+	ring.writes_inflight += ring.writes_queued;
+	ring.writes_queued = 0;
+	ring.last_write = NULL;
+	reap();
+}
+
+/* Submit now, whatever is in flight */
+static void ring_submit_now(void)
+{
+	if (ring.writes_queued)
+		wait_writes();
+	ring_submit();
+}
+
+static struct io_uring_sqe *get_sqe(void)
+{
+	struct io_uring_sqe *sqe;
+	unsigned idx;
+
+	if (ring.tail - __atomic_load_n(ring.sq_head, __ATOMIC_ACQUIRE) ==
+	    ring.entries)
+		ring_submit_now();
+
+	idx = ring.tail++ & *ring.sq_mask;
+	ring.sq_array[idx] = idx;
+	ring.queued++;
+	sqe = &ring.sqes[idx];
+	memset(sqe, 0, sizeof(*sqe));
+
+	return sqe;
+}
+
+static void post_read(struct uring_read *r)
+{
+	struct io_uring_sqe *sqe = get_sqe();
+
+	sqe->opcode = IORING_OP_READ;
+	sqe->fd = r->dev->src.fd;
+	sqe->addr = (uintptr_t)r->ev;
+	sqe->len = sizeof(r->ev);
+	sqe->off = -1;
+	sqe->user_data = (uintptr_t)r;
+	r->posted = 1;
+	/* Link flag goes to the next entry, which must be a write */
+	ring.last_write = NULL;
+}
+
+/* Queued after whatever was written before, sent at the end of the batch */
+static int uring_write(struct sink *sink, const struct input_event *ev,
+		       int cnt)
+{
+	struct io_uring_sqe *sqe;
+	ssize_t len = cnt * sizeof(*ev);
+
+	if (cnt > URING_WRITE_EVENTS - wbuf_cnt) {
+		ring_submit_now();
+		wait_writes();
+	}
+	/* Too much to queue at all, write it the old way */
+	if (cnt > URING_WRITE_EVENTS) {
+		stats.writes++;
+		if (write(sink->fd, ev, len) != len) {
+			warn("Error during event sending: %s\n", strerror(errno));
+			return -1;
+		}
+		return 0;
+	}
+
+	sqe = get_sqe();
+	memcpy(wbuf + wbuf_cnt, ev, len);
+	sqe->opcode = IORING_OP_WRITE;
+	sqe->fd = sink->fd;
+	sqe->addr = (uintptr_t)(wbuf + wbuf_cnt);
+	sqe->len = len;
+	sqe->off = -1;
+	sqe->user_data = URING_WRITE;
+	if (ring.last_write)
+		ring.last_write->flags |= IOSQE_IO_LINK;
+	ring.last_write = sqe;
+	ring.writes_queued++;
+	wbuf_cnt += cnt;
+
+	return 0;
+}
+
+/* Reads and cancels are submitted right away, so they never get into a
+ * chain of linked writes, and never wait in the ring for a device which
+ * may be gone by then
+ */
+static int uring_start(struct evdev *dev)
+{
+	struct uring_read *r;
+	int flags;
+
+	r = calloc(1, sizeof(*r));
+	if (!r) {
+		warn("Could not allocate read: %s\n", strerror(errno));
+		return -1;
+	}
+
+	/* Reads wait in the kernel, they would fail with EAGAIN otherwise */
+	flags = fcntl(dev->src.fd, F_GETFL);
+	if (flags == -1 ||
+	    fcntl(dev->src.fd, F_SETFL, flags & ~O_NONBLOCK) == -1) {
+		warn("Could not set %s blocking: %s\n", dev->path, strerror(errno));
+		free(r);
+		return -1;
+	}
+
+	r->dev = dev;
+	dev->uring = r;
+	post_read(r);
+	ring_submit_now();
+
+	return 0;
+}
+
+static void uring_stop(struct evdev *dev)
+{
+	struct uring_read *r = dev->uring;
+	struct io_uring_sqe *sqe;
+
+	if (!r)
+		return;
+
+	r->dev = NULL;
+	dev->uring = NULL;
+	/* Otherwise it's completed and on one of the lists, freed from there */
+	if (!r->posted)
+		return;
+
+	sqe = get_sqe();
+	sqe->opcode = IORING_OP_ASYNC_CANCEL;
+	sqe->addr = (uintptr_t)r;
+	sqe->user_data = URING_CANCEL;
+	ring_submit_now();
+}
+
+static void handle_read(struct uring_read *r)
+{
+	struct evdev *dev = r->dev;
+
+	if (r->res > 0) {
+		handler(dev, r->ev, r->res / sizeof(struct input_event));
+		return;
+	}
+	if (r->res == -EINTR || r->res == -EAGAIN)
+		return;
+
+	if (r->res < 0 && r->res != -ENODEV)
+		warn("Read from %s returned error: %s\n", dev->path,
+		     strerror(-r->res));
+	device_remove(dev);
+}
+
+/* Held back writes go at the end of the batch, in uring_submit() */
+static void process_ring(struct source *src)
+{
+	reap();
+}
+
+/* Completions were reaped while submitting, nothing will wake the loop */
+int uring_ready(void)
+{
+	return ready != NULL;
+}
+
+/* Events of completed reads, in the event loop */
+void uring_process(void)
+{
+	struct uring_read *r;
+
+	while (ready) {
+		r = ready;
+		ready = r->next;
+		if (r->dev)
+			handle_read(r);
+		r->next = idle;
+		idle = r;
+	}
+}
+
+/* End of the batch: writes and reads to post again go in one syscall.
+ * Reads wait while writes are held back, so the chain of linked writes
+ * grows with the next batch and never has a read in the middle
+ */
+void uring_submit(void)
+{
+	struct uring_read *r, *next;
+
+	if (ring_src.fd == -1 || writes_held())
+		return;
+
+	for (r = idle; r; r = next) {
+		next = r->next;
+		if (r->dev)
+			post_read(r);
+		else
+			free(r);
+	}
+	idle = NULL;
+
+	ring_submit();
+}
+
+void uring_sink(struct sink *sink)
+{
+	if (ring_src.fd != -1)
+		sink->write = uring_write;
+}
+
+static void ring_unmap(void)
+{
+	if (ring.sqes)
+		munmap(ring.sqes, ring.sqes_len);
+	if (ring.cq_ptr && ring.cq_ptr != ring.sq_ptr)
+		munmap(ring.cq_ptr, ring.cq_len);
+	if (ring.sq_ptr)
+		munmap(ring.sq_ptr, ring.sq_len);
+	memset(&ring, 0, sizeof(ring));
+}
+
+/* Switch devices and uinput sinks over to io_uring, before any of them is
+ * opened. Nothing is changed if it's not supported
+ */
+int uring_init(reader_handler fn)
+{
+	struct io_uring_params p;
+	void *ptr;
+
+	memset(&p, 0, sizeof(p));
+	ring_src.fd = syscall(__NR_io_uring_setup, URING_ENTRIES, &p);
+	if (ring_src.fd == -1) {
+		warn("Could not set up io_uring: %s\n", strerror(errno));
+		return -1;
+	}
+	/* Reads and writes at current position came in 5.6 */
+	if (!(p.features & IORING_FEAT_RW_CUR_POS)) {
+		warn("io_uring is too old\n");
+		goto err;
+	}
+
+	ring.sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+	ring.cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	if (p.features & IORING_FEAT_SINGLE_MMAP) {
+		if (ring.cq_len > ring.sq_len)
+			ring.sq_len = ring.cq_len;
+		ring.cq_len = ring.sq_len;
+	}
+
+	ptr = mmap(NULL, ring.sq_len, PROT_READ | PROT_WRITE,
+		   MAP_SHARED | MAP_POPULATE, ring_src.fd, IORING_OFF_SQ_RING);
+	if (ptr == MAP_FAILED)
+		goto err_map;
+	ring.sq_ptr = ptr;
+
+	if (!(p.features & IORING_FEAT_SINGLE_MMAP)) {
+		ptr = mmap(NULL, ring.cq_len, PROT_READ | PROT_WRITE,
+			   MAP_SHARED | MAP_POPULATE, ring_src.fd,
+			   IORING_OFF_CQ_RING);
+		if (ptr == MAP_FAILED)
+			goto err_map;
+	}
+	ring.cq_ptr = ptr;
+
+	ring.sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+	ptr = mmap(NULL, ring.sqes_len, PROT_READ | PROT_WRITE,
+		   MAP_SHARED | MAP_POPULATE, ring_src.fd, IORING_OFF_SQES);
+	if (ptr == MAP_FAILED)
+		goto err_map;
+	ring.sqes = ptr;
+
+	ring.sq_head = (unsigned *)((char *)ring.sq_ptr + p.sq_off.head);
+	ring.sq_tail = (unsigned *)((char *)ring.sq_ptr + p.sq_off.tail);
+	ring.sq_mask = (unsigned *)((char *)ring.sq_ptr + p.sq_off.ring_mask);
+	ring.sq_array = (unsigned *)((char *)ring.sq_ptr + p.sq_off.array);
+	ring.cq_head = (unsigned *)((char *)ring.cq_ptr + p.cq_off.head);
+	ring.cq_tail = (unsigned *)((char *)ring.cq_ptr + p.cq_off.tail);
+	ring.cq_mask = (unsigned *)((char *)ring.cq_ptr + p.cq_off.ring_mask);
+	ring.cqes = (struct io_uring_cqe *)((char *)ring.cq_ptr + p.cq_off.cqes);
+	ring.entries = p.sq_entries;
+	ring.tail = *ring.sq_tail;
+
+	if (loop_add(&ring_src, EPOLLIN))
+		goto err;
+
+	handler = fn;
+	device_start = uring_start;
+	device_stop = uring_stop;
+
+	return 0;
+err_map:
+	warn("Could not map io_uring: %s\n", strerror(errno));
+err:
+	ring_unmap();
+	close(ring_src.fd);
+	ring_src.fd = -1;
+	return -1;
+}
+
+void uring_close(void)
+{
+	if (ring_src.fd == -1)
+		return;
+
+	ring_unmap();
+	close(ring_src.fd);
+	ring_src.fd = -1;
+}
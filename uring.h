@@ -0,0 +1,57 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#ifndef __URING_H
+#define __URING_H
+
+#include "devices.h"
+#include "readers.h"
+#include "sink.h"
+
+/* Submission queue entries, a read per device and writes of a batch */
+#define URING_ENTRIES 256
+/* Events read from a device at once */
+#define URING_READ_EVENTS 64
+/* Events of uinput writes in flight */
+#define URING_WRITE_EVENTS 4096
+
+#ifdef HAVE_IO_URING
+
+int uring_init(reader_handler handler);
+void uring_sink(struct sink *sink);
+int uring_ready(void);
+void uring_process(void);
+void uring_submit(void);
+void uring_close(void);
+
+#else
+
+/* Built without io_uring, everything goes through epoll */
+static inline int uring_init(reader_handler handler) { return -1; }
+static inline void uring_sink(struct sink *sink) { }
+static inline int uring_ready(void) { return 0; }
+static inline void uring_process(void) { }
+static inline void uring_submit(void) { }
+static inline void uring_close(void) { }
+
+#endif
+
+#endif
@@ -0,0 +1,189 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "wheel.h"
+
+static void slot_link(struct wheel *wheel, struct timer *timer)
+{
+	uint64_t expires = timer->expires, delta;
+	int level, slot;
+
+	/* Already due ones run with the next ms */
+	if (expires < wheel->now)
+		expires = wheel->now;
+	delta = expires - wheel->now;
+	if (delta > WHEEL_MAX)
+		expires = wheel->now + WHEEL_MAX;
+
+	for (level = 0; level < WHEEL_LEVELS - 1; level++) {
+		if (delta < 1ULL << (WHEEL_BITS * (level + 1)))
+			break;
+	}
+	slot = (expires >> (WHEEL_BITS * level)) & WHEEL_MASK;
+	wheel->used[level] |= 1ULL << slot;
+	slot += level * WHEEL_SIZE;
+
+	timer->slot = slot;
+	timer->next = wheel->slots[slot];
+	if (timer->next)
+		timer->next->pprev = &timer->next;
+	timer->pprev = &wheel->slots[slot];
+	wheel->slots[slot] = timer;
+}
+
+static void slot_unlink(struct wheel *wheel, struct timer *timer)
+{
+	*timer->pprev = timer->next;
+	if (timer->next)
+		timer->next->pprev = timer->pprev;
+	if (timer->slot != -1 && !wheel->slots[timer->slot])
+		wheel->used[timer->slot / WHEEL_SIZE] &=
+			~(1ULL << (timer->slot % WHEEL_SIZE));
+}
+
+/* Takes all timers out of the slot into list, which they can be removed
+ * from as usual
+ */
+static void slot_take(struct wheel *wheel, int level, int idx,
+		      struct timer **list)
+{
+	struct timer *timer;
+	int slot = level * WHEEL_SIZE + idx;
+
+	*list = wheel->slots[slot];
+	wheel->slots[slot] = NULL;
+	wheel->used[level] &= ~(1ULL << idx);
+	if (*list)
+		(*list)->pprev = list;
+	for (timer = *list; timer; timer = timer->next)
+		timer->slot = -1;
+}
+
+static void cascade(struct wheel *wheel, int level, int idx)
+{
+	struct timer *list, *timer;
+
+	slot_take(wheel, level, idx, &list);
+	while ((timer = list)) {
+		slot_unlink(wheel, timer);
+		slot_link(wheel, timer);
+	}
+}
+
+/* Run the current ms, moving down slots of upper levels which begin at it
+ * first
+ */
+static void wheel_tick(struct wheel *wheel)
+{
+	struct timer *list, *timer;
+	int level, idx = wheel->now & WHEEL_MASK;
+
+	for (level = 1; !idx && level < WHEEL_LEVELS; level++) {
+		idx = (wheel->now >> (WHEEL_BITS * level)) & WHEEL_MASK;
+		cascade(wheel, level, idx);
+	}
+
+	slot_take(wheel, 0, wheel->now & WHEEL_MASK, &list);
+	/* Timers added by callbacks go after this ms */
+	wheel->now++;
+	while ((timer = list)) {
+		timer_del(wheel, timer);
+		timer->fn(timer);
+	}
+}
+
+void wheel_init(struct wheel *wheel)
+{
+	memset(wheel, 0, sizeof(*wheel));
+}
+
+/* Slot is picked by how far expires is from where the wheel has run up to,
+ * so run it up to the current time first
+ */
+void timer_add(struct wheel *wheel, struct timer *timer, uint64_t expires)
+{
+	if (timer_pending(timer))
+		timer_del(wheel, timer);
+
+	timer->expires = expires;
+	slot_link(wheel, timer);
+	wheel->cnt++;
+}
+
+void timer_del(struct wheel *wheel, struct timer *timer)
+{
+	if (!timer_pending(timer))
+		return;
+
+	slot_unlink(wheel, timer);
+	timer->pprev = NULL;
+	timer->next = NULL;
+	wheel->cnt--;
+}
+
+/* When the wheel has something to do next, a timer to run or a slot to
+ * move down. UINT64_MAX if it's empty
+ */
+uint64_t wheel_next(const struct wheel *wheel)
+{
+	uint64_t next = UINT64_MAX, used, span, when;
+	int level, shift, idx;
+
+	for (level = 0; level < WHEEL_LEVELS; level++) {
+		used = wheel->used[level];
+		if (!used)
+			continue;
+		/* Spans of a level begin when lower levels are at slot 0, this
+		 * is the first one not begun yet
+		 */
+		shift = WHEEL_BITS * level;
+		span = (wheel->now + (1ULL << shift) - 1) >> shift;
+		/* Rotate the bits so its slot is bit 0 */
+		idx = span & WHEEL_MASK;
+		if (idx)
+			used = used >> idx | used << (WHEEL_SIZE - idx);
+		when = (span + __builtin_ctzll(used)) << shift;
+		if (when < next)
+			next = when;
+	}
+
+	return next;
+}
+
+/* Run timers expiring up to now. Milliseconds with nothing to do are
+ * skipped over at once
+ */
+void wheel_run(struct wheel *wheel, uint64_t now)
+{
+	uint64_t next;
+
+	while (wheel->now <= now) {
+		next = wheel_next(wheel);
+		if (next > now) {
+			wheel->now = now + 1;
+			break;
+		}
+		wheel->now = next;
+		wheel_tick(wheel);
+	}
+}
@@ -0,0 +1,68 @@
+/*
+ *  mouse-emul - Tiny mouse emulator
+ *  Copyright (C) 2011 Vasily Khoruzhick (anarsoul@gmail.com)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef __WHEEL_H
+#define __WHEEL_H
+
+#include <stdint.h>
+
+/* Hierarchical timer wheel, time is in ms. Level 0 has a slot for each of
+ * the next 64 ms, slots of every next level span 64 times more. Timers are
+ * put into a slot by how far off they are, and moved a level down when
+ * their slot comes up, so adding, removing and running a timer take the
+ * same time however many are pending
+ */
+#define WHEEL_BITS 6
+#define WHEEL_SIZE (1 << WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SIZE - 1)
+#define WHEEL_LEVELS 4
+/* About 4.6 hours, timers further off wait in the top level for a round */
+#define WHEEL_MAX ((1ULL << (WHEEL_BITS * WHEEL_LEVELS)) - 1)
+
+struct timer {
+	struct timer *next, **pprev;
+	/* Index into slots of the wheel, -1 while it's being run */
+	int slot;
+	uint64_t expires;
+	void (*fn)(struct timer *timer);
+};
+
+struct wheel {
+	/* Next ms to be run, everything before it is */
+	uint64_t now;
+	struct timer *slots[WHEEL_LEVELS * WHEEL_SIZE];
+	/* A bit per slot with timers in it, for each level */
+	uint64_t used[WHEEL_LEVELS];
+	int cnt;
+};
+
+/* Not pending unless pprev is set, a zeroed timer is fine */
+static inline int timer_pending(const struct timer *timer)
+{
+	return timer->pprev != NULL;
+}
+
+void wheel_init(struct wheel *wheel);
+void timer_add(struct wheel *wheel, struct timer *timer, uint64_t expires);
+void timer_del(struct wheel *wheel, struct timer *timer);
+uint64_t wheel_next(const struct wheel *wheel);
+void wheel_run(struct wheel *wheel, uint64_t now);
+
+#endif